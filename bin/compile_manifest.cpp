@@ -0,0 +1,35 @@
+/**
+ * Build tool which checks a text resource manifest and compiles it into a binary manifest, which
+ * the game loads without having to parse anything or compute any polygons. Polygons traced from
+ * sprites are traced here, from images found the same way the game finds them, so run this from a
+ * directory next to data/. Usage:
+ * 
+ *     compile_manifest <text manifest> <binary manifest>
+ */
+
+#include <iostream>
+
+#include "ResourceManifest.hpp"
+
+int main(int argc, char** argv) {
+
+    if (argc != 3) {
+        std::cerr << "usage: " << argv[0] << " <text manifest> <binary manifest>" << std::endl;
+        return 1;
+    }
+
+    // problems with the manifest are printed while loading it
+    ResourceManifest manifest;
+    if (!manifest.load(argv[1]))
+        return 1;
+
+    if (!manifest.save(argv[2])) {
+        std::cerr << "unable to write " << argv[2] << std::endl;
+        return 1;
+    }
+
+    std::cout << "compiled " << manifest.textures.size() + manifest.sprites.size() +
+            manifest.fonts.size() + manifest.polygons.size() << " resources into " << argv[2] <<
+            std::endl;
+    return 0;
+}
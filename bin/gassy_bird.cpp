@@ -1,20 +1,173 @@
 #include <iostream>
+#include <string>
+#include <fstream>
+#include <cstdlib>
+#include <cerrno>
+#include <limits>
+#include <cmath>
 
 #include <SFML/Graphics.hpp>
 #include <box2d/box2d.h>
 
 #include "Game.hpp"
+#include "Globals.hpp"
+#include "EventJournal.hpp"
+#include "ResourceCache.hpp"
+#include "CourseFile.hpp"
 
 int main(int argc, char** argv) {
 
+    // parse command line options
+    bool printEventStats = false;
+    bool printResourceStats = false;
+    bool printJobStats = false;
+    bool printFrameStats = false;
+    float framerateLimit = 60.0f;
+    bool verticalSync = false;
+    bool inputThread = false;
+    bool printInputStats = false;
+    bool printUpdateStats = false;
+    bool renderThread = false;
+    std::string journalFilename;
+    std::string courseFilename;
+    std::string manifestFilename;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg(argv[i]);
+        if (arg == "--event-stats")
+            printEventStats = true;
+        else if (arg == "--journal" && i + 1 < argc)
+            journalFilename = argv[++i];
+        else if (arg == "--course" && i + 1 < argc)
+            courseFilename = argv[++i];
+        else if (arg == "--resource-stats")
+            printResourceStats = true;
+        else if (arg == "--job-stats")
+            printJobStats = true;
+        else if (arg == "--frame-stats")
+            printFrameStats = true;
+        else if (arg == "--fps" && i + 1 < argc) {
+            // the rate is a number of frames per second, where 0 means no limit
+            const char* value = argv[++i];
+            char* end = nullptr;
+            errno = 0;
+            float rate = std::strtof(value, &end);
+            if (end == value || *end != '\0' || errno == ERANGE || !std::isfinite(rate) ||
+                    rate < 0.0f)
+                std::cerr << "invalid frame rate: " << value << std::endl;
+            else
+                framerateLimit = rate;
+        } else if (arg == "--vsync")
+            verticalSync = true;
+        else if (arg == "--input-thread")
+            inputThread = true;
+        else if (arg == "--input-stats")
+            printInputStats = true;
+        else if (arg == "--update-stats")
+            printUpdateStats = true;
+        else if (arg == "--render-thread")
+            renderThread = true;
+        else if (arg == "--lazy-resources")
+            resourceCache.setLazyLoading(true);
+        else if (arg == "--manifest" && i + 1 < argc)
+            manifestFilename = argv[++i];
+        else if (arg == "--texture-budget" && i + 1 < argc) {
+            // the budget is a whole number of megabytes, which has to fit in bytes
+            const char* value = argv[++i];
+            char* end = nullptr;
+            errno = 0;
+            unsigned long long megabytes = std::strtoull(value, &end, 10);
+            if (end == value || *end != '\0' || *value == '-' || errno == ERANGE ||
+                    megabytes > std::numeric_limits<std::size_t>::max() / (1024 * 1024))
+                std::cerr << "invalid texture budget: " << value << std::endl;
+            else
+                resourceCache.setTextureBudget(megabytes * 1024 * 1024);
+        } else
+            std::cerr << "unknown option: " << arg << std::endl;
+    }
+
+    // only time the event listeners if the statistics are going to be printed
+    eventMessenger.setStatsEnabled(printEventStats);
+
+    // if a journal file was given, then record all events into it
+    EventJournal journal;
+    if (!journalFilename.empty()) {
+        if (journal.open(journalFilename))
+            eventMessenger.setJournal(&journal);
+        else
+            std::cerr << "unable to open journal file: " << journalFilename << std::endl;
+    }
+
+    std::string executable(argv[0]);
+    std::size_t separator = executable.find_last_of("/\\");
+    std::string directory =
+            separator == std::string::npos ? "" : executable.substr(0, separator + 1);
+
+    // Use the manifest that was given, otherwise the compiled manifest next to the executable if it
+    // was built, otherwise the text manifest in the data directory.
+    if (manifestFilename.empty()) {
+        manifestFilename = directory + "resources.manifest.bin";
+        if (!std::ifstream(manifestFilename))
+            manifestFilename = "../data/resources.manifest";
+    }
+    if (!resourceCache.openManifest(manifestFilename)) {
+        std::cerr << "unable to load resource manifest: " << manifestFilename << std::endl;
+        return 1;
+    }
+
+    // Load resources from the archive next to the executable if it was built from this manifest.
+    // Otherwise they're loaded from their own files.
+    resourceCache.openArchive(directory + "resources.pak");
+
+    // if a course file was given, then play it instead of a random course
+    CourseFile course;
+    if (!courseFilename.empty() && !course.open(courseFilename))
+        std::cerr << "unable to open course file: " << courseFilename << std::endl;
+
     // create and initialize game
     Game game;
+    if (course.isOpen())
+        game.setCourseFile(&course);
+    game.setRenderThreadEnabled(renderThread);
+    game.setInputThreadEnabled(inputThread);
+    game.setFramerateLimit(framerateLimit);
+    game.setVerticalSyncEnabled(verticalSync);
     game.init();
 
     // game loop
     while (game.update())
         game.draw();
     
+    // print event dispatch statistics if requested
+    if (printEventStats)
+        eventMessenger.printStats(std::cout);
+
+    // print resource sizes and load times if requested
+    if (printResourceStats)
+        resourceCache.printStats(std::cout);
+
+    // print frame times and their jitter if requested
+    if (printFrameStats)
+        game.getFramePacer().printStats(std::cout);
+
+    // print input latency if requested
+    if (printInputStats)
+        game.printInputStats(std::cout);
+
+    // print how many updates of off-screen actors were skipped if requested
+    if (printUpdateStats)
+        game.printUpdateStats(std::cout);
+
+    // print how long the jobs of each frame took if requested
+    if (printJobStats)
+        game.getJobSystem().printStats(std::cout);
+
+    // stop recording events and write what's left of the journal
+    if (journal.isOpen()) {
+        eventMessenger.setJournal(nullptr);
+        journal.close();
+        if (journal.getNumDropped() > 0)
+            std::cerr << journal.getNumDropped() << " journal records were dropped" << std::endl;
+    }
 
     // exit
     return 0;
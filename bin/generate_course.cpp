@@ -0,0 +1,57 @@
+/**
+ * Offline tool which generates a course file from a seed, for the game's --course option. The same
+ * seed always generates the same course. The records are printed as they're generated, one per
+ * line. Usage:
+ * 
+ *     generate_course <seed> <length in meters> <output file>
+ */
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+#include "CourseFile.hpp"
+#include "CourseGenerator.hpp"
+
+int main(int argc, char** argv) {
+
+    if (argc != 4) {
+        std::cerr << "usage: " << argv[0] << " <seed> <length in meters> <output file>"
+                << std::endl;
+        return 1;
+    }
+
+    std::uint32_t seed = std::stoul(argv[1]);
+    float length = std::stof(argv[2]);
+
+    // generate stretches until the course is long enough, the same way the game does while playing
+    CourseGenerator generator(seed);
+    std::vector<CourseRecord> records;
+    float position = 0.0f;
+    while (position < length || records.empty()) {
+
+        records.push_back(generator.next());
+        const CourseRecord& record = records.back();
+
+        std::cout << position << " " << CourseRecord::getKindName(record.kind);
+        if (record.npc != CourseRecord::NO_NPC)
+            std::cout << " npc=" << (record.npc == CourseRecord::MALE ? "MALE" : "FEMALE");
+        if (record.faceLeft)
+            std::cout << " faceLeft";
+        std::cout << " offset=" << record.offset << " length=" << record.length << " values=("
+                << record.values[0] << ", " << record.values[1] << ", " << record.values[2] << ")"
+                << std::endl;
+
+        position += record.length;
+    }
+
+    if (!CourseFile::write(argv[3], seed, records)) {
+        std::cerr << "unable to write " << argv[3] << std::endl;
+        return 1;
+    }
+
+    std::cout << records.size() << " records, " << position << " meters" << std::endl;
+
+    return 0;
+}
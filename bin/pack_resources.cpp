@@ -0,0 +1,40 @@
+/**
+ * Build tool which packs all textures (decoded to raw RGBA) and fonts listed in a resource manifest
+ * into one resource archive. The game loads the archive from its own directory if it exists.
+ * Resource files are found the same way the game finds them, i.e. relative to the working
+ * directory, so run this from a directory next to data/. Usage:
+ * 
+ *     pack_resources <manifest file> <archive file>
+ */
+
+#include <iostream>
+
+#include "Globals.hpp"
+#include "ResourceCache.hpp"
+#include "ResourceArchiveWriter.hpp"
+
+int main(int argc, char** argv) {
+
+    if (argc != 3) {
+        std::cerr << "usage: " << argv[0] << " <manifest file> <archive file>" << std::endl;
+        return 1;
+    }
+
+    if (!resourceCache.openManifest(argv[1]))
+        return 1;
+
+    // collect every resource from the resource cache
+    ResourceArchiveWriter writer;
+    if (!resourceCache.pack(writer)) {
+        std::cerr << "unable to read all resource files" << std::endl;
+        return 1;
+    }
+
+    if (!writer.write(argv[2])) {
+        std::cerr << "unable to write " << argv[2] << std::endl;
+        return 1;
+    }
+
+    std::cout << "packed " << writer.getNumEntries() << " resources into " << argv[2] << std::endl;
+    return 0;
+}
@@ -0,0 +1,100 @@
+/**
+ * Offline tool which prints the contents of an event journal recorded with the --journal option,
+ * one record per line. Usage:
+ * 
+ *     read_event_journal <journal file>
+ */
+
+#include <iostream>
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+
+#include "EventJournal.hpp"
+#include "PhysicalActor.hpp"
+
+/**
+ * Returns the name of the given PhysicalActor::TYPE.
+ */
+const char* actorTypeName(const uint8_t& type) {
+    switch ((PhysicalActor::TYPE)type) {
+    case PhysicalActor::TYPE::GENERIC_OBSTACLE: return "GENERIC_OBSTACLE";
+    case PhysicalActor::TYPE::GROUND:           return "GROUND";
+    case PhysicalActor::TYPE::NPC:              return "NPC";
+    case PhysicalActor::TYPE::PLAYABLE_BIRD:    return "PLAYABLE_BIRD";
+    case PhysicalActor::TYPE::POOP:             return "POOP";
+    case PhysicalActor::TYPE::PROJECTILE:       return "PROJECTILE";
+    default:                                    return "undefined";
+    }
+}
+
+int main(int argc, char** argv) {
+
+    if (argc != 2) {
+        std::cerr << "usage: " << argv[0] << " <journal file>" << std::endl;
+        return 1;
+    }
+
+    std::FILE* file = std::fopen(argv[1], "rb");
+    if (!file) {
+        std::cerr << "unable to open " << argv[1] << std::endl;
+        return 1;
+    }
+
+    // read and check the header
+    char magic[4];
+    uint32_t header[2];
+    bool validHeader =
+        std::fread(magic, 1, 4, file) == 4 &&
+        std::fread(header, sizeof(uint32_t), 2, file) == 2 &&
+        std::memcmp(magic, "GBEJ", 4) == 0 &&
+        header[0] == EventJournal::VERSION &&
+        header[1] == sizeof(EventJournalRecord);
+    if (!validHeader) {
+        std::cerr << argv[1] << " is not a version " << EventJournal::VERSION << " event journal"
+                << std::endl;
+        std::fclose(file);
+        return 1;
+    }
+
+    // print every record
+    EventJournalRecord record;
+    unsigned long numRecords = 0;
+    while (std::fread(&record, sizeof(record), 1, file) == 1) {
+
+        ++numRecords;
+        std::cout << record.tick << " " << EventJournalRecord::getTypeName(record.type);
+
+        switch (record.type) {
+        case EventJournalRecord::COLLISION:
+            std::cout << " " << actorTypeName(record.actorTypes[0]) << " "
+                    << actorTypeName(record.actorTypes[1]) << " position=(" << record.values[0]
+                    << ", " << record.values[1] << ") normalAngle=" << record.values[2];
+            break;
+        case EventJournalRecord::KEY_PRESS:
+        case EventJournalRecord::KEY_RELEASE:
+            std::cout << " key=" << record.code;
+            break;
+        case EventJournalRecord::MOUSE_PRESS:
+        case EventJournalRecord::MOUSE_RELEASE:
+            std::cout << " button=" << record.code;
+            // fall through
+        case EventJournalRecord::MOUSE_MOVE:
+            std::cout << " position=(" << record.values[0] << ", " << record.values[1] << ")";
+            break;
+        case EventJournalRecord::WINDOW_RESIZE:
+            std::cout << " size=" << record.values[0] << "x" << record.values[1];
+            break;
+        case EventJournalRecord::GAME_PAUSE:
+            std::cout << (record.code == 0 ? " PAUSE" : " UNPAUSE");
+            break;
+        }
+
+        std::cout << std::endl;
+    }
+
+    std::cerr << numRecords << " records" << std::endl;
+
+    std::fclose(file);
+    return 0;
+}
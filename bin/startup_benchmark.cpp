@@ -0,0 +1,99 @@
+/**
+ * Tool which measures how long loading all resources takes, the way the game does it on startup.
+ * Compares loading every texture and font one after the other, like the game used to, with
+ * ResourceCache::init() decoding them on one worker thread and on as many as the game uses. Either
+ * way, the glyphs of the fonts' character sizes are rendered as well. Each way is timed a few times
+ * and the fastest time is printed, after one pass that warms up the file cache.
+ * Like the game, run this from a directory next to data/. Usage:
+ * 
+ *     startup_benchmark <manifest file> [runs]
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <chrono>
+#include <thread>
+#include <functional>
+#include <algorithm>
+
+#include <SFML/Graphics.hpp>
+
+#include "ResourceCache.hpp"
+#include "ResourceManifest.hpp"
+#include "Resources/FontResource.hpp"
+
+/**
+ * Runs the given function the given number of times and returns the fastest time in milliseconds.
+ */
+float bestTime(const int& runs, const std::function<void()>& function) {
+
+    float best = 0.0f;
+    for (int i = 0; i < runs; ++i) {
+        auto start = std::chrono::steady_clock::now();
+        function();
+        std::chrono::duration<float, std::milli> time = std::chrono::steady_clock::now() - start;
+        best = i == 0 ? time.count() : std::min(best, time.count());
+    }
+    return best;
+}
+
+int main(int argc, char** argv) {
+
+    if (argc != 2 && argc != 3) {
+        std::cerr << "usage: " << argv[0] << " <manifest file> [runs]" << std::endl;
+        return 1;
+    }
+
+    const std::string manifestFilename(argv[1]);
+    const int runs = argc == 3 ? std::max(std::stoi(argv[2]), 1) : 3;
+
+    ResourceManifest manifest;
+    if (!manifest.load(manifestFilename))
+        return 1;
+
+    // The old way: every file is loaded and uploaded by the main thread, one after the other. The
+    // fonts' glyphs are rendered like init() renders them, so that both do the same work.
+    auto loadSerially = [&manifest]() {
+        for (const ResourceManifest::Texture& texture : manifest.textures) {
+            sf::Texture t;
+            t.loadFromFile(texture.filename);
+        }
+        for (const ResourceManifest::Font& font : manifest.fonts) {
+            FontResource f(font.filename, 0);
+            f.renderGlyphs(font.characterSizes);
+        }
+    };
+
+    // a fresh cache every time, since a cache can only be initialized once
+    auto loadWithCache = [&manifestFilename](const unsigned& numThreads) {
+        ResourceCache cache;
+        cache.openManifest(manifestFilename);
+        cache.setLoaderThreads(numThreads);
+        cache.init();
+    };
+
+    // by default, the cache's worker pool leaves one hardware thread for the main thread
+    unsigned hardwareThreads = std::thread::hardware_concurrency();
+    unsigned gameThreads = hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+
+    // warm up the file cache, so that the first way timed doesn't pay for reading from disk
+    loadSerially();
+
+    float serialTime = bestTime(runs, loadSerially);
+    float oneThreadTime = bestTime(runs, std::bind(loadWithCache, 1u));
+    float gameThreadsTime = bestTime(runs, std::bind(loadWithCache, 0u));
+
+    std::cout << "Loading " << manifest.textures.size() << " textures and " <<
+            manifest.fonts.size() << " fonts, best of " << runs << " runs:" << std::endl;
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "  serial:                  " << std::setw(8) << serialTime << " ms" << std::endl;
+    std::cout << "  init(), 1 thread:        " << std::setw(8) << oneThreadTime << " ms" <<
+            std::endl;
+    std::cout << "  init(), " << std::left << std::setw(3) << gameThreads << std::right <<
+            " threads:     " << std::setw(8) << gameThreadsTime << " ms (" <<
+            std::setprecision(2) << serialTime / gameThreadsTime << "x faster than serial)" <<
+            std::endl;
+
+    return 0;
+}
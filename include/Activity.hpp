@@ -3,6 +3,8 @@
 
 #include <SFML/Graphics.hpp>
 
+#include "RenderSnapshot.hpp"
+
 /**
  * An Activity describes one "screen" of the game. Classes that implement the Activity interface
  * are able to update themselves (step their internal state forward) and draw themselves. Activities
@@ -30,9 +32,9 @@ public:
     virtual void update(const float& timeDelta) = 0;
 
     /**
-     * Draws the screen onto the given target.
+     * Records the screen into the given snapshot, which is drawn onto the window afterwards.
      */
-    virtual void draw(sf::RenderTarget& target) = 0;
+    virtual void draw(RenderSnapshot& snapshot) = 0;
     
 };
 
@@ -3,11 +3,13 @@
 
 #include <SFML/Graphics.hpp>
 
+#include "RenderSnapshot.hpp"
+
 /**
  * An Actor is an entity that exists in the game that knows how to update it's local state and draw
  * itself on the screen (however, Actors don't have to be visible).
  */
-class Actor : public sf::Drawable {
+class Actor {
 
 public:
 
@@ -28,11 +30,12 @@ public:
     virtual void update(const float& timeDelta) {}
 
     /**
-     * Draws the actor onto the given render target; therefore, everything needed to know how to
-     * draw the actor should be stored in the derived class's members. This method does not update
-     * the actor's state.
+     * Records the actor into the given render snapshot, drawn with the given render states;
+     * therefore, everything needed to know how to draw the actor should be stored in the derived
+     * class's members. This method does not update the actor's state.
      */
-    virtual void draw(sf::RenderTarget& target, sf::RenderStates states) const override {}
+    virtual void draw(RenderSnapshot& snapshot,
+            const sf::RenderStates& states = sf::RenderStates::Default) const {}
 };
 
 #endif // _ACTOR_HPP_
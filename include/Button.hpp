@@ -76,7 +76,8 @@ public:
     /**
      * Draws the shape and text.
      */
-    void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
+    void draw(RenderSnapshot& snapshot,
+            const sf::RenderStates& states = sf::RenderStates::Default) const override;
 
 private:
 
@@ -0,0 +1,96 @@
+#ifndef _COURSE_FILE_HPP_
+#define _COURSE_FILE_HPP_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "MappedFile.hpp"
+
+/**
+ * A single fixed-size record in a course, describing one stretch of it: a Non-Playable Entity
+ * (Obstacle or NPC), possibly with an NPC standing on it, and the room that it takes up. Distances
+ * are in meters and relative to the start of the stretch, which is where the previous stretch ends.
+ * The meaning of the values depends on the record's kind:
+ *   - STREETLIGHT, TREE: values[0] holds the height
+ *   - CLOUD: values[0] holds the y-position
+ *   - DOCKS: values[0] and values[1] hold the width and height, values[2] holds the x-offset of the
+ *     NPC standing on the docks, if there is one
+ *   - UMBRELLA: values[0] holds the angle
+ *   - LIFEGUARD, LONE_NPC: no values
+ */
+struct CourseRecord {
+
+    enum KIND : uint8_t {STREETLIGHT, TREE, CLOUD, LIFEGUARD, DOCKS, UMBRELLA, LONE_NPC};
+    enum NPC_KIND : uint8_t {NO_NPC, MALE, FEMALE};
+
+    /**
+     * Returns the name of the given kind, used for output by offline tools.
+     */
+    static const char* getKindName(const uint8_t& kind);
+
+    uint8_t kind;     // one of the KIND values
+    uint8_t npc;      // one of the NPC_KIND values, always set for LONE_NPC
+    uint8_t faceLeft; // 1 if the entity faces left
+    uint8_t padding;
+    float offset;     // x-offset of the entity from the start of the stretch
+    float length;     // distance from the start of the stretch to the start of the next one
+    float values[3];
+};
+
+static_assert(sizeof(CourseRecord) == 24, "course records must have a fixed layout");
+
+/**
+ * Read-only access to a course file, i.e. a pre-generated sequence of course records which the
+ * game logic can spawn instead of generating the course as it goes. The file is memory mapped, so
+ * its records are only read from disk as the course reaches them.
+ *
+ * Layout: a header ("GBCO", version, number of records, seed that the course was generated from;
+ * all uint32 except the magic), followed by the records. Everything is stored in the native byte
+ * order, like the resource archive.
+ */
+class CourseFile {
+
+public:
+
+    CourseFile() : _numRecords(0), _seed(0) {}
+
+    /**
+     * Maps the course with the given filename. Fails if the file doesn't exist or isn't a valid
+     * course of the current version.
+     * @return true if the course was opened, false otherwise
+     */
+    bool open(const std::string& filename);
+
+    void close();
+
+    bool isOpen() const { return _file.isOpen(); }
+
+    std::size_t getNumRecords() const { return _numRecords; }
+
+    std::uint32_t getSeed() const { return _seed; }
+
+    /**
+     * Returns the record at the given index, which must be less than getNumRecords().
+     */
+    const CourseRecord& getRecord(const std::size_t& index) const;
+
+    /**
+     * Writes the given records into a course file with the given filename, overwriting it.
+     * @return true if the file was written, false otherwise
+     */
+    static bool write(const std::string& filename, const std::uint32_t& seed,
+            const std::vector<CourseRecord>& records);
+
+    static const char MAGIC[4];
+    static const std::uint32_t VERSION = 1;
+    static const std::uint32_t HEADER_SIZE = 16;
+
+private:
+
+    MappedFile _file;
+    std::size_t _numRecords;
+    std::uint32_t _seed;
+};
+
+#endif // _COURSE_FILE_HPP_
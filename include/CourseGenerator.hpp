@@ -0,0 +1,50 @@
+#ifndef _COURSE_GENERATOR_HPP_
+#define _COURSE_GENERATOR_HPP_
+
+#include <cstdint>
+#include <random>
+
+#include "CourseFile.hpp"
+
+/**
+ * Rolls the dice for the course: decides what comes next and where, in the form of course records,
+ * without making any actors. Each generator has its own random engine, so two generators given the
+ * same seed generate the same course, which is how course files are generated offline. A generator
+ * must only be used by one thread at a time.
+ */
+class CourseGenerator {
+
+public:
+
+    CourseGenerator(const std::uint32_t& seed);
+
+    /**
+     * Restarts the generator as though it were just constructed with the given seed.
+     */
+    void seed(const std::uint32_t& seed);
+
+    /**
+     * Generates the next stretch of the course. The same kind of entity isn't generated twice in a
+     * row, and an NPC is always generated if there hasn't been one for a screen's width.
+     *
+     * @param forceNPC generates an NPC regardless, e.g. because there aren't any on screen
+     * @param demoBirdHeight if this isn't negative, then the stretch is generated for the DEMO
+     *                       state: obstacles are lower, and clouds stay clear of the bird, which
+     *                       flies at this height
+     */
+    CourseRecord next(const bool& forceNPC = false, const float& demoBirdHeight = -1.0f);
+
+private:
+
+    // random numbers from the generator's own engine, in the same ranges as the ones in Utils
+    int rollInt(const int& low, const int& high);
+    float rollFloat(const float& low, const float& high);
+    bool rollBool();
+
+    std::default_random_engine _engine;
+    int _lastKind; // kind of the last non-NPC entity, -1 if there wasn't one yet
+    float _distanceSinceNPC;
+    const float _MAX_DISTANCE_BETWEEN_NPCS;
+};
+
+#endif // _COURSE_GENERATOR_HPP_
@@ -4,9 +4,11 @@
 #include <SFML/Graphics.hpp>
 #include <box2d/box2d.h>
 
+#include "RenderSnapshot.hpp"
+
 /**
  * Used by box2d for debug drawing, i.e. draws the exact positions of hitboxes, centers of mass,
- * etc.
+ * etc. The shapes are recorded into the snapshot of the frame being drawn.
  */
 class DebugDrawer : public b2Draw {
 
@@ -17,10 +19,12 @@ public:
      */
     DebugDrawer();
 
+    void init();
+
     /**
-     * Initializes with a render target.
+     * Sets the snapshot that the following draw calls are recorded into.
      */
-    void init(sf::RenderTarget& target);
+    void setSnapshot(RenderSnapshot& snapshot);
 
     /**
      * Draws a closed polygon, with vertices provided in CCW order.
@@ -62,7 +66,7 @@ private:
 
     bool _initialized;
 
-    sf::RenderTarget* _renderTarget;
+    RenderSnapshot* _snapshot;
 
     const float _OUTLINE_THICKNESS;
 };
@@ -0,0 +1,85 @@
+#ifndef _DEMO_RECORDING_HPP_
+#define _DEMO_RECORDING_HPP_
+
+#include <cstdint>
+#include <vector>
+#include <unordered_map>
+
+#include <SFML/Graphics.hpp>
+
+#include "RenderSnapshot.hpp"
+#include "GameLogic.hpp"
+#include "PhysicalActor.hpp"
+
+/**
+ * A recording of what the visible actors looked like and where they were, frame by frame, which
+ * can be drawn again without simulating anything. Used to replay the demo behind the main menu.
+ * 
+ * Each distinct look of an actor, e.g. one frame of the bird's animation, is recorded once, as the
+ * snapshot that the actor draws when it's at the origin. Each frame is then just a list of looks
+ * and where they're placed, in drawing order. The looks refer to the actors' textures, which must
+ * stay loaded as long as the recording is drawn.
+ */
+class DemoRecording {
+
+public:
+
+    DemoRecording();
+
+    /**
+     * Forgets everything that was recorded.
+     */
+    void clear();
+
+    /**
+     * Records the visible actors of the given logic as the next frame, which comes timeDelta
+     * seconds after the previous one.
+     */
+    void recordFrame(const GameLogic& logic, const float& timeDelta);
+
+    /**
+     * Returns the length of the recording in seconds.
+     */
+    float getLength() const { return _length; }
+
+    /**
+     * Draws the actors of the frame at the given time into the given snapshot. Times past the end
+     * of the recording wrap around to the start.
+     */
+    void draw(RenderSnapshot& snapshot, const float& time) const;
+
+private:
+
+    // one of the looks placed somewhere, in graphical coordinates
+    struct Placement {
+        std::uint16_t look;
+        float x;
+        float y;
+        float rotation; // degrees
+    };
+
+    // a recorded frame, which is made of the placements from its own index up to the next frame's
+    struct Frame {
+        float time; // seconds from the start of the recording
+        std::size_t firstPlacement;
+    };
+
+    /**
+     * Returns the index of the look that the given actor has right now, and records it if it's
+     * new.
+     */
+    int findLook(const PhysicalActor* actor);
+
+    std::vector<RenderSnapshot> _looks;
+    std::vector<Placement> _placements;
+    std::vector<Frame> _frames;
+    float _length;
+
+    // the last look of each actor, since actors usually look the same as in the previous frame
+    std::unordered_map<const PhysicalActor*, int> _lastLooks;
+
+    // what the actor being recorded looks like
+    RenderSnapshot _look;
+};
+
+#endif // _DEMO_RECORDING_HPP_
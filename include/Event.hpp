@@ -12,4 +12,10 @@ public:
     virtual const EventType& getType() const = 0;
 };
 
+/**
+ * Returns the name of the class which has the given event type, e.g. "CollisionEvent". Returns
+ * "UnknownEvent" if the type doesn't belong to any known event class. Used for debug output.
+ */
+const char* getEventTypeName(const EventType& type);
+
 #endif // _EVENT_HPP_
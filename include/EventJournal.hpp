@@ -0,0 +1,147 @@
+#ifndef _EVENT_JOURNAL_HPP_
+#define _EVENT_JOURNAL_HPP_
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#include "Event.hpp"
+
+/**
+ * A single fixed-size record in an event journal file. The meaning of the payload depends on the
+ * record's type:
+ *   - COLLISION: actorTypes holds the PhysicalActor::TYPEs of both actors, values holds the x and
+ *     y position of the collision followed by its normal angle
+ *   - KEY_PRESS, KEY_RELEASE: code holds the sf::Keyboard::Key
+ *   - MOUSE_MOVE, MOUSE_PRESS, MOUSE_RELEASE: code holds the sf::Mouse::Button (0 for MOUSE_MOVE),
+ *     values holds the graphical x and y position of the mouse
+ *   - WINDOW_RESIZE: values holds the new width and height of the window
+ *   - GAME_PAUSE: code holds 0 for PAUSE and 1 for UNPAUSE
+ *   - WINDOW_CLOSE, BUTTON_CLICK, GAME_OVER, OTHER: no payload
+ */
+struct EventJournalRecord {
+
+    enum TYPE : uint8_t {
+        OTHER,
+        COLLISION,
+        KEY_PRESS,
+        KEY_RELEASE,
+        MOUSE_MOVE,
+        MOUSE_PRESS,
+        MOUSE_RELEASE,
+        WINDOW_RESIZE,
+        WINDOW_CLOSE,
+        BUTTON_CLICK,
+        GAME_PAUSE,
+        GAME_OVER
+    };
+
+    /**
+     * Returns the name of the given record type, used for output by offline tools.
+     */
+    static const char* getTypeName(const uint8_t& type);
+
+    uint32_t tick;         // frame during which the event was triggered
+    uint8_t type;          // one of the TYPE values
+    uint8_t actorTypes[2];
+    uint8_t padding;
+    int32_t code;
+    float values[3];
+};
+
+static_assert(sizeof(EventJournalRecord) == 24, "journal records must have a fixed layout");
+
+/**
+ * Records every triggered event into a binary journal file, so that gameplay and performance
+ * issues can be diagnosed after the fact with an offline tool. The event messenger calls record()
+ * for every event it dispatches once the journal is given to it with EventMessenger::setJournal().
+ * 
+ * Recording an event only fills in a record in a preallocated buffer. Once per frame, flush() hands
+ * the buffer to a background thread which writes it to the file, so the game never waits on disk
+ * IO. If the background thread falls so far behind that the buffer fills up, then new records are
+ * dropped (and counted) instead of blocking.
+ * 
+ * The journal isn't written through a memory mapping (see MappedFile for reading one), because a
+ * mapping has to be sized up front and remapped to grow, and the first write to each of its pages
+ * faults on the game thread, possibly waiting on the file system to allocate the page. Filling
+ * preallocated buffers costs the same per event, and keeps all of that on the writer thread.
+ * 
+ * The file starts with a header made up of the 4 characters "GBEJ", followed by the journal
+ * version and the size of a record as uint32s in the machine's byte order. The rest of the file is a sequence of
+ * EventJournalRecords.
+ */
+class EventJournal {
+
+public:
+
+    EventJournal();
+
+    /**
+     * Destructor; closes the journal if it's open.
+     */
+    ~EventJournal();
+
+    /**
+     * Opens the journal file with the given filename and starts the background writer thread. The
+     * file is overwritten if it exists. recordsPerFrame is the number of records which can be
+     * recorded between calls to flush() before records start being dropped.
+     * 
+     * @return true if the file was able to be opened, false otherwise
+     */
+    bool open(const std::string& filename, const size_t& recordsPerFrame = 4096);
+
+    /**
+     * Writes all remaining records, stops the writer thread, and closes the file. Does nothing if
+     * the journal isn't open.
+     */
+    void close();
+
+    bool isOpen() const { return _file != nullptr; }
+
+    /**
+     * Serializes the given event into a record with the given tick.
+     */
+    void record(const unsigned long& tick, const Event& event);
+
+    /**
+     * Hands the records recorded so far to the writer thread, unless the writer thread is still
+     * busy with the previous batch, in which case they will be handed over on a later flush().
+     */
+    void flush();
+
+    /**
+     * Returns the number of records that had to be dropped because the buffer was full.
+     */
+    unsigned long getNumDropped() const { return _numDropped; }
+
+    static const uint32_t VERSION = 1;
+
+private:
+
+    /**
+     * Loop run by the writer thread, writes batches of records to the file until the journal is
+     * closed.
+     */
+    void writerLoop();
+
+    std::FILE* _file;
+    size_t _capacity;
+    unsigned long _numDropped;
+
+    // records are recorded into the active buffer, handed over to the writer thread by swapping
+    // with the pending buffer, and then swapped into the writing buffer by the writer thread
+    std::vector<EventJournalRecord> _activeBuffer;
+    std::vector<EventJournalRecord> _pendingBuffer;
+    std::vector<EventJournalRecord> _writingBuffer;
+
+    std::thread _writerThread;
+    std::mutex _mutex;
+    std::condition_variable _condition;
+    bool _closing;
+};
+
+#endif // _EVENT_JOURNAL_HPP_
@@ -6,13 +6,48 @@
 #include <array>
 #include <functional>
 #include <memory>
+#include <ostream>
 
 #include "Event.hpp"
 #include "EventListener.hpp"
+#include "EventJournal.hpp"
 
 typedef std::list<std::shared_ptr<Event>> EventQueue;
 typedef std::list<const EventListener*> ListenerList;
 
+/**
+ * Dispatch statistics for a single event type. Times are given in seconds.
+ *   - numTriggered: number of times the event was triggered immediately with triggerEvent()
+ *   - numQueued: number of times the event was queued with queueEvent()
+ *   - numListenerCalls: total number of listeners invoked for the event, queued or not
+ *   - totalHandlerTime: total time spent inside the event's listeners, which includes the time
+ *     spent on any events that the listeners triggered themselves
+ *   - maxHandlerTime: longest time spent inside a single listener call
+ *   - maxQueuedPerFrame: most events of this type that were triggered from the queue in one frame
+ */
+struct EventStats {
+
+    EventStats() :
+        numTriggered(0),
+        numQueued(0),
+        numListenerCalls(0),
+        totalHandlerTime(0.0),
+        maxHandlerTime(0.0),
+        maxQueuedPerFrame(0),
+        queuedThisFrame(0)
+    {}
+
+    unsigned long numTriggered;
+    unsigned long numQueued;
+    unsigned long numListenerCalls;
+    double totalHandlerTime;
+    double maxHandlerTime;
+    unsigned long maxQueuedPerFrame;
+
+    // used by the event messenger to compute maxQueuedPerFrame
+    unsigned long queuedThisFrame;
+};
+
 /**
  * A system which handles Events and EventListeners. Every stored EventListener is associated with
  * some Event type. When an event is triggered, all listeners associated with the event's type are
@@ -29,7 +64,12 @@ public:
     /**
      * Default constructor.
      */
-    EventMessenger() {}
+    EventMessenger() :
+        _journal(nullptr),
+        _statsEnabled(false),
+        _maxQueuedPerFrame(0),
+        _frameCount(0)
+    {}
 
     /**
      * Adds an event listener which will be called when an event of eventType is triggered.
@@ -60,8 +100,12 @@ public:
      */
     template <typename T>
     void queueEvent(const T& event) {
+
         // copy event and push to second queue
         _eventQueues.at(1).push_back(std::make_shared<T>(event));
+
+        if (_statsEnabled)
+            ++_stats[event.getType()].numQueued;
     }
 
     /**
@@ -73,6 +117,42 @@ public:
      */
     void triggerEvent(const Event& event);
 
+    /**
+     * Enables or disables the collection of dispatch statistics. Statistics aren't collected by
+     * default, since timing every listener call costs two clock reads. Disabling collection does
+     * not clear statistics that were already collected.
+     */
+    void setStatsEnabled(const bool& enabled) { _statsEnabled = enabled; }
+
+    /**
+     * Returns the dispatch statistics collected so far, by event type. Event types which were never
+     * queued or triggered do not have an entry.
+     */
+    const std::unordered_map<EventType, EventStats>& getStats() const { return _stats; }
+
+    /**
+     * Returns the largest number of events that were triggered from the queue in a single frame.
+     */
+    unsigned long getMaxQueuedPerFrame() const { return _maxQueuedPerFrame; }
+
+    /**
+     * Returns the number of frames, i.e. the number of times the queued events have been triggered.
+     */
+    unsigned long getFrameCount() const { return _frameCount; }
+
+    /**
+     * Writes the collected statistics to the given stream as a table, one row per event type. The
+     * stream's formatting is left as it was.
+     */
+    void printStats(std::ostream& out) const;
+
+    /**
+     * Sets the journal into which every dispatched event is recorded, pass nullptr to stop
+     * recording. The journal must be open, and it must remain valid until it's removed from the
+     * event messenger.
+     */
+    void setJournal(EventJournal* journal) { _journal = journal; }
+
     // the Game class is the only class able to trigger all queued events
     friend class Game;
 
@@ -84,6 +164,12 @@ private:
      */
     void triggerQueuedEvents();
 
+    /**
+     * Calls all listeners associated with the given event's type. This is what both triggerEvent()
+     * and triggerQueuedEvents() use to do the actual dispatching.
+     */
+    void dispatchEvent(const Event& event);
+
     // stores events listeners by event type
     std::unordered_map<EventType, ListenerList> _listeners;
 
@@ -92,6 +178,15 @@ private:
     // the first queue (once the second queue) are triggered. This queue swapping technique ensures
     // that events cannot be pushed to the first queue while triggerQueuedEvents() is running.
     std::array<EventQueue, 2> _eventQueues;
+
+    // optional journal which records all dispatched events
+    EventJournal* _journal;
+
+    // dispatch statistics
+    bool _statsEnabled;
+    std::unordered_map<EventType, EventStats> _stats;
+    unsigned long _maxQueuedPerFrame;
+    unsigned long _frameCount;
 };
 
 #endif // _EVENT_MESSENGER_HPP_
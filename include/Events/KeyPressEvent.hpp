@@ -4,12 +4,13 @@
 
 class KeyPressEvent: public Event {
 public:
-    KeyPressEvent(const sf::Keyboard::Key key) : key(key) {}
+    KeyPressEvent(const sf::Keyboard::Key key, const float& age = 0.0f) : key(key), age(age) {}
 
     const EventType& getType() const override { return TYPE; }
 
     static const EventType TYPE;
 
     const sf::Keyboard::Key key;
+    const float age; // how long ago the key was pressed, in seconds
 };
 #endif
\ No newline at end of file
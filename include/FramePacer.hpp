@@ -0,0 +1,85 @@
+#ifndef _FRAME_PACER_HPP_
+#define _FRAME_PACER_HPP_
+
+#include <chrono>
+#include <iostream>
+
+/**
+ * Limits the frame rate by waiting until each frame is due. The frames are due at fixed intervals,
+ * so waiting late for one frame doesn't delay the ones after it, unless the game falls behind by a
+ * whole frame.
+ * 
+ * Sleeping is imprecise, since the thread may wake up a while after it asked to, so the pacer
+ * sleeps until shortly before the frame is due, then spins for the rest. How long it spins follows
+ * how late sleeping has woken up so far, so that little time is spent spinning on systems which
+ * sleep precisely.
+ * 
+ * The time between frames is measured, and its deviation from the target is reported as jitter by
+ * printStats().
+ */
+class FramePacer {
+
+public:
+
+    FramePacer();
+
+    /**
+     * Sets the number of frames per second to pace to; 0 means no limit, in which case wait()
+     * returns right away.
+     */
+    void setTargetRate(const float& framesPerSecond);
+
+    float getTargetRate() const { return _targetRate; }
+
+    /**
+     * Waits until the next frame is due, and measures the time since the previous frame.
+     */
+    void wait();
+
+    /**
+     * Forgets when the previous frame was, so that the next frame is due one period from now and
+     * the time until then isn't measured. Used when the game wasn't running frames for a while.
+     */
+    void restart();
+
+    /**
+     * Writes the frame time statistics to the given stream.
+     */
+    void printStats(std::ostream& out) const;
+
+private:
+
+    typedef std::chrono::steady_clock Clock;
+
+    /**
+     * Sleeps for roughly the given duration, and updates the estimate of how late sleeping wakes up.
+     */
+    void sleep(const Clock::duration& duration);
+
+    float _targetRate;
+    Clock::duration _period;
+
+    // when the next frame is due, and when the previous frame started
+    Clock::time_point _nextFrame;
+    Clock::time_point _lastFrame;
+    bool _started;
+
+    // running average and deviation of how late sleeping wakes up, in seconds
+    double _sleepError;
+    double _sleepErrorDeviation;
+
+    // spin at least this long, and never longer than this (seconds)
+    const double _MIN_SPIN_TIME;
+    const double _MAX_SPIN_TIME;
+
+    // frame time statistics, in seconds
+    unsigned long _numFrames;
+    double _totalFrameTime;
+    double _totalSquaredFrameTime;
+    double _minFrameTime;
+    double _maxFrameTime;
+    unsigned long _numLateFrames; // frames that took over a millisecond longer than the target
+    double _totalSpinTime;
+};
+
+#endif // _FRAME_PACER_HPP_
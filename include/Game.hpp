@@ -2,11 +2,23 @@
 #define _GAME_HPP_
 
 #include <memory>
+#include <vector>
+#include <iostream>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
 
 #include <SFML/Graphics.hpp>
 
 #include "Activity.hpp"
 #include "PlayingActivity.hpp"
+#include "LoadingActivity.hpp"
+#include "RenderSnapshot.hpp"
+#include "TripleBuffer.hpp"
+#include "JobSystem.hpp"
+#include "FramePacer.hpp"
+#include "InputSampler.hpp"
 
 #include "Globals.hpp"
 #include "EventListener.hpp"
@@ -14,6 +26,13 @@
 
 /**
  * The Game class serves as the application layer.
+ * 
+ * Every frame, the current activity records what it draws into a render snapshot. Normally the
+ * snapshot is drawn onto the window right away, on the same thread. With a render thread, the
+ * snapshot is published through a triple buffer instead, and the render thread draws and displays
+ * the latest published snapshot while the next frame is being simulated, so that neither waits on
+ * the other. The render thread starts once resources are loaded, and the resource cache is frozen
+ * then so that no texture a snapshot refers to is ever evicted.
  */
 class Game {
 
@@ -30,24 +49,101 @@ public:
     ~Game();
 
     /**
-     * Initializes the window and the first activity. Also initializes any game-related global
-     * structures.
+     * Initializes the window and the loading activity, and starts loading resources in the
+     * background. Also initializes any game-related global structures.
      */
     void init();
 
     /**
-     * Handle the polling of SFML events, then pass the update task on to the current activity.
+     * Sets whether snapshots are drawn by a separate render thread. Must be called before init().
+     */
+    void setRenderThreadEnabled(const bool& enabled);
+
+    /**
+     * Sets whether an input thread times key presses more precisely than once per frame. Must be
+     * called before init().
+     */
+    void setInputThreadEnabled(const bool& enabled);
+
+    /**
+     * Sets the number of frames per second that the game is paced to, 0 means no limit. Defaults
+     * to 60.
+     */
+    void setFramerateLimit(const float& framesPerSecond);
+
+    /**
+     * Sets whether displaying waits for the monitor's vertical sync. Must be called before init().
+     */
+    void setVerticalSyncEnabled(const bool& enabled);
+
+    /**
+     * Sets the course file which the course is taken from while playing, or nullptr for a random
+     * course. The file must stay open for as long as the game runs.
+     */
+    void setCourseFile(const CourseFile* courseFile);
+
+    /**
+     * Wait until the frame is due, handle the polling of SFML events, then pass the update task on
+     * to the current activity. While the game is idle, this blocks until there's an event instead.
      * @return true if the game window is still open, false otherwise
      */
     bool update();
 
     /**
-     * Clear, draw, and display the screen.
+     * Returns the job system which runs the parallel parts of each frame.
+     */
+    const JobSystem& getJobSystem() const { return _jobSystem; }
+
+    /**
+     * Returns the frame pacer, which measures the time between frames.
+     */
+    const FramePacer& getFramePacer() const { return _framePacer; }
+
+    /**
+     * Writes how many key presses were timed by the input thread, and how long they took to reach
+     * the simulation, to the given stream.
+     */
+    void printInputStats(std::ostream& out) const;
+
+    /**
+     * Writes how many updates of actors were skipped while they were off the screen, for each type
+     * of actor, to the given stream.
+     */
+    void printUpdateStats(std::ostream& out) const;
+
+    /**
+     * Records the current activity into a snapshot, then clears, draws, and displays the screen,
+     * or hands the snapshot to the render thread if it's running. Does nothing if the game is idle
+     * and there were no events since the last draw, since the screen wouldn't change.
      */
-    void draw() const;
+    void draw();
 
 private:
 
+    /**
+     * Returns true if the game is idle, i.e. it's paused or the window doesn't have focus. Nothing
+     * moves while idle, so frames only need to be updated and drawn when there's input.
+     */
+    bool isIdle() const;
+
+    /**
+     * Waits until the window has an event and returns true, or returns false once the timeout has
+     * passed without one.
+     */
+    bool waitEvent(sf::Event& event, const sf::Time& timeout);
+
+    /**
+     * Returns how many seconds ago the given key was pressed or released, to cause an event that
+     * was just polled. If the input thread didn't time it, then it's assumed to have happened at
+     * the start of the time step that the next update covers.
+     */
+    float getKeyAge(const sf::Keyboard::Key& key, const bool& pressed);
+
+    /**
+     * Turns the given SFML event into the game's own events.
+     */
+    void handleEvent(const sf::Event& event);
+
     /**
      * Handles resizing of the window by changing the window's viewport. The viewport will be as
      * large as possible such that the native aspect ratio is maintained. If the window is taller
@@ -62,6 +158,18 @@ private:
      * @param event should be a WindowCloseEvent
      */
     void windowCloseHandler(const Event& event);
+
+    /**
+     * Start and stop the render thread. The window's OpenGL context is handed over to the render
+     * thread while it's running.
+     */
+    void startRenderThread();
+    void stopRenderThread();
+
+    /**
+     * Body of the render thread. Draws and displays each newly published snapshot until stopped.
+     */
+    void render();
     
     bool _initialized;
 
@@ -72,12 +180,58 @@ private:
     // the render window onto which to draw
     std::shared_ptr<sf::RenderWindow> _window;
 
-    // activities, for now there's only a PlayingActivity
+    // The view that snapshots are drawn with. The window's own view belongs to whichever thread
+    // draws, so mouse coordinates are mapped with this one.
+    sf::View _view;
+
+    // snapshots recorded by draw(), and the render thread which draws them if it's enabled
+    TripleBuffer<RenderSnapshot> _snapshots;
+    bool _renderThreadEnabled;
+    std::thread _renderThread;
+    std::atomic<bool> _rendering;
+    std::mutex _renderMutex;
+    std::condition_variable _renderCondition; // signaled when a snapshot is published or stopping
+
+    // waits for each frame to be due, and whether the window waits for vertical sync
+    FramePacer _framePacer;
+    bool _verticalSyncEnabled;
+
+    // idle mode; the window's focus, and whether anything may have changed since the last draw
+    bool _hasFocus;
+    bool _needsRedraw;
+    const sf::Time _IDLE_POLL_TIME; // how often events are polled while idle
+    const sf::Time _IDLE_REDRAW_TIME; // the frame is redrawn this often while idle, even without
+                                      // events
+
+    // times key presses and releases on its own thread
+    InputSampler _inputSampler;
+    bool _inputThreadEnabled;
+
+    // key presses timed by the input thread which haven't reached the simulation yet, and
+    // statistics about how long it took them (seconds)
+    std::vector<InputSampler::Clock::time_point> _pendingKeyPresses;
+    unsigned long _numKeyPresses;
+    unsigned long _numTimedKeyPresses;
+    double _totalPollDelay; // from the key press until its event was polled
+    double _totalInputLatency; // from the key press until the simulation was updated with it
+    double _maxInputLatency;
+
+    // runs the jobs of each frame on all cores
+    JobSystem _jobSystem;
+
+    // activities -- the LoadingActivity is shown until all resources are loaded, then the
+    // PlayingActivity takes over
+    LoadingActivity _loadingActivity;
     PlayingActivity _playingActivity;
     Activity* _currentActivity;
 
-    // game clock
+    // max number of textures uploaded per frame while loading, so that the loading screen doesn't
+    // stutter
+    const int _TEXTURE_UPLOADS_PER_FRAME;
+
+    // game clock, and when it was last restarted
     sf::Clock _clock;
+    InputSampler::Clock::time_point _lastUpdate;
 
     // time difference between the current fame and the previous frame, recalculated every frame
     float _timeDelta;
@@ -3,7 +3,11 @@
 
 #include <memory>
 #include <unordered_map>
+#include <map>
 #include <list>
+#include <vector>
+#include <deque>
+#include <mutex>
 #include <iostream>
 
 #include <box2d/box2d.h>
@@ -17,6 +21,9 @@
 #include "EventListener.hpp"
 #include "Event.hpp"
 #include "ContactListener.hpp"
+#include "CourseFile.hpp"
+#include "CourseGenerator.hpp"
+#include "TimerWheel.hpp"
 
 /**
  * Encodes the mechanics of the game and stores actors with physical properties. Provides an API
@@ -33,10 +40,28 @@ public:
     void init();
 
     /**
-     * Advances the state of the game forward in time by the amount given by timeDelta.
+     * Sets the course file which the course is taken from while playing, or nullptr to generate a
+     * random course as usual. The file must stay open while it's set. The course starts over from
+     * its first record every time the game starts, and it repeats once all of its records have
+     * been spawned. The demo's course is always random.
+     */
+    void setCourseFile(const CourseFile* courseFile);
+
+    /**
+     * Advances the state of the game forward in time by the amount given by timeDelta. The actors'
+     * animations and timed actions run on the logic's timer wheel as it's advanced.
      */
     void update(const float& timeDelta);
 
+    /**
+     * Plans the next stretch of the course ahead of the spawn location, i.e. makes the NPEs which
+     * generateNewActors() only has to add to the world later on, until the plan reaches a few
+     * screens ahead. It only touches the plan, so it can run on a worker at the same time as
+     * update(), but not at the same time as itself, toDemo() or toPlaying(). Making the NPEs uses
+     * the resource cache, so it must be frozen for this to be called from another thread.
+     */
+    void planCourse();
+
     /**
      * Methods to transition to different states.
      */
@@ -81,14 +106,18 @@ public:
      * These methods are called by the HumanView to start and stop the bird from flying. When the
      * bird is flying, an upward force is applied to it. When it is not flying, gravity makes the
      * bird move downward.
+     * 
+     * The requests, including the one below, take effect during the next update(), at the point
+     * within it where the input happened, given by how many seconds ago it happened (age). Inputs
+     * older than the update's whole time step take effect at its start.
      */
-    void requestBirdStartFly();
-    void requestBirdStopFly();
+    void requestBirdStartFly(const float& age = 0.0f);
+    void requestBirdStopFly(const float& age = 0.0f);
 
     /**
      * Called by the HumanView to cause the bird to poop.
      */
-    void requestBirdPoop();
+    void requestBirdPoop(const float& age = 0.0f);
 
     /**
      * Called by NPCView to cause the specified NPC to do the specified action. The action starts
@@ -96,6 +125,41 @@ public:
      */
     void requestNPCAction(NPC& npc, const NPC::ACTION& action, const float& delay,
             const float& duration);
+
+    // how much of the update of an actor is skipped while it's off the screen
+    enum class OFFSCREEN_POLICY {
+        FULL,    // updated just like on the screen
+        REDUCED, // not animated, and not given anything new to do by the views
+        FROZEN   // also taken out of the physics, drifting at its last velocity if it's dynamic
+    };
+
+    /**
+     * Sets how much of the update of actors of the given type is skipped while they're off the
+     * screen. Actors are caught up when they come back onto it, e.g. an NPC's animation continues
+     * at the frame it would have reached by then. Since frozen actors don't fall, those that drift
+     * off to the right and would never come back are removed. The bird and the ground are never
+     * skipped. By default, NPCs are REDUCED and every other type is FROZEN.
+     */
+    void setOffscreenPolicy(const PhysicalActor::TYPE& type, const OFFSCREEN_POLICY& policy);
+
+    /**
+     * Returns true if the given actor is off the screen and its updates are being skipped, in
+     * which case views shouldn't bother giving it anything to do.
+     */
+    bool isSkippingUpdates(const PhysicalActor& actor) const;
+
+    /**
+     * Writes the off-screen policy of each actor type, how many of the updates of its actors were
+     * skipped, and how many of its actors are frozen right now, to the given stream.
+     */
+    void printUpdateStats(std::ostream& out) const;
+
+    /**
+     * Returns the bird's position relative to the given actor's position. This is how the logic and
+     * views tell where the bird is from an actor's point of view, which is cheap because the logic
+     * always knows where the bird is.
+     */
+    b2Vec2 getOffsetToBird(const PhysicalActor& actor) const;
     
     // Store collision filtering info here so other classes may access them. The bird and rock don't
     // collide with the npcGround, but they do collide with each other. The splatter doesn't
@@ -119,12 +183,31 @@ private:
     void handleBirdCollision(const CollisionEvent& e);
 
     /**
-     * Spawns the first physical actors into existence, i.e. creates the ground and sprinkles some
-     * other entities in there as well. This does not add the playable bird to the world, so need to
-     * do that separately.
+     * Queues a GameOverEvent, unless one is already queued. The event is queued rather than
+     * triggered, so that its listeners don't run in the middle of an update.
+     */
+    void queueGameOver();
+
+    /**
+     * Spawns the physical actors which exist for the whole lifetime of the logic, i.e. the ground
+     * obstacles and the playable bird. These are recycled by resetMap() rather than recreated.
      */
     void createMap();
 
+    /**
+     * Puts the world back into its initial state: removes everything that was spawned, moves the
+     * ground and the bird back to where they started, and adds the NPEs prepared by
+     * prepareNextMap(), finishing the preparation first if needed.
+     */
+    void resetMap();
+
+    /**
+     * Prepares the NPEs which populate the screen after the next resetMap(), without adding them
+     * to the world yet. Makes only a single NPE per call unless `finish` is true, so that the work
+     * can be spread across the frames of the game over screen.
+     */
+    void prepareNextMap(const bool& finish);
+
     /**
      * Removes physical actors that are past a certain threshold to the left of the screen. This
      * does not affect the bird or the ground.
@@ -137,13 +220,61 @@ private:
      */
     void generateNewActors(const float& timeDelta);
 
+    // a Non-Playable Entity (Obstacle or NPC) which has been made but not necessarily added yet
+    struct NPE {
+        std::shared_ptr<Obstacle> obstacle; // only one of obstacle and npc is set
+        std::shared_ptr<NPC> npc;
+        b2Vec2 position;
+    };
+
+    // NPEs which have been made but not added to the world yet
+    struct Course {
+        std::vector<NPE> npes;
+        float rightmost; // right edge of the last NPE, plus some breathing room
+    };
+
     /**
-     * Helper method to generateNewActors(). Spawns a random Non-Playable Entity (Obstacle or NPC)
-     * at the given position in the world. Also updates _rightmostObstacleLocation according to the
-     * right edge of the spawned obstacle.
+     * Helper method to generateNewActors(). Spawns a random NPE at the given position in the world.
+     * Also updates _rightmostObstacleLocation according to the right edge of the spawned obstacle.
      */
     void spawnNPE(b2Vec2 position);
 
+    /**
+     * Helper method to generateNewActors(). Adds the next stretch planned by planCourse() to the
+     * world at the spawn location, and updates _rightmostObstacleLocation accordingly. Returns
+     * false if there's no stretch to use.
+     */
+    bool spawnPlannedStretch();
+
+    /**
+     * Throws away the planned course, e.g. because it was planned for another state, and has the
+     * planner plan for the given state from now on.
+     */
+    void discardPlannedCourse(const bool& forDemo);
+
+    /**
+     * Returns true if any of the given course's NPEs is an NPC.
+     */
+    static bool hasNPC(const Course& course);
+
+    /**
+     * Makes the NPEs described by the given course record, as though the record's stretch starts
+     * at the given position, and appends them to the course without adding them to the world. Sets
+     * the course's rightmost location to the end of the stretch.
+     */
+    void makeStretch(const CourseRecord& record, const b2Vec2& start, Course& course);
+
+    /**
+     * Returns true if the planner takes the course from a course file, which is the case in every
+     * state but DEMO when a course file was given.
+     */
+    bool isFollowingCourseFile() const;
+
+    /**
+     * Adds an NPE made by makeStretch() to the world and to the matching actor list.
+     */
+    void addNPE(const NPE& npe);
+
     /**
      * Creates a b2Body from the given physical actor, and adds it to the box2d world and to the
      * physical actors map. The user data of the created box2d body is set to the address of the
@@ -175,10 +306,18 @@ private:
     void removeFromWorld(const PhysicalActor& actor);
 
     /**
-     * Calls removeFromWorld() on every actor in the _physicalActors map.
+     * Removes every actor from the world and frees the ones in the actor lists, and cancels every
+     * pending timer. Unlike calling removeFromWorld() on each actor, this doesn't search the lists,
+     * so it takes linear time.
      */
     void removeAllFromWorld();
 
+    /**
+     * Same as removeAllFromWorld(), except that the ground obstacles and the playable bird are
+     * kept, along with their bodies.
+     */
+    void removeSpawnedFromWorld();
+
     /**
      * Searches for the shared pointer which holds the given actor in the given list of shared
      * pointers. It frees the memory of all matches and removes the entries from the list.
@@ -198,9 +337,31 @@ private:
         }
     }
     
+    // requests made to the bird, which are applied at some point within the next update
+    enum BIRD_REQUEST {START_FLY, STOP_FLY, POOP};
+    struct BirdRequest {
+        BIRD_REQUEST type;
+        float age; // seconds ago that the input happened
+    };
+
+    /**
+     * Does what the given request asked for, if it's still allowed.
+     */
+    void applyBirdRequest(const BIRD_REQUEST& request);
+
+    /**
+     * Calls the timers which expire within the given time, then updates the bird and steps the
+     * physical world forward by it.
+     */
+    void stepWorld(const float& timeDelta);
+
     /**
-     * Updates stuff about the bird, e.g. whether it's pooping, whether it's flying, etc. Also calls
-     * the bird's own update() method.
+     * Restarts the bird's poop cooldown and death timers, as though the bird just pooped.
+     */
+    void restartPoopTimers();
+
+    /**
+     * Updates stuff about the bird, e.g. whether it's flying, how fast it's moving, etc.
      */
     void updatePlayableBird(const float& timeDelta);
 
@@ -216,6 +377,21 @@ private:
      */
     void updateGround();
 
+    /**
+     * Skips the parts of the update of off-screen actors that their types' policies skip, and
+     * catches up the actors that came back onto the screen.
+     */
+    void updateOffscreenActors(const float& timeDelta);
+
+    /**
+     * Returns true if the given body's position is on the screen, or at most the given margin
+     * off it. By default the margin is how far off the screen an actor may still be partly visible,
+     * which is what decides whether its updates are skipped. NPCs only count as visible without a
+     * margin, so every visible NPC is also updated in full.
+     */
+    bool isOnScreen(const b2Body* body, const float& margin) const;
+    bool isOnScreen(const b2Body* body) const { return isOnScreen(body, _OFFSCREEN_MARGIN); }
+
     /**Difficulty is calculated based on the total time elapsed
     */
     void updateDifficulty();
@@ -227,6 +403,10 @@ private:
 
     bool _initialized;
 
+    // Times everything that should happen after a while, e.g. the bird dying or the NPCs finishing
+    // their actions. Advanced as the world is stepped, so it stops while the game is paused.
+    TimerWheel _timers;
+
     // event listeners
     EventListener _gamePauseListener;
     EventListener _collisionListener;
@@ -241,6 +421,9 @@ private:
     // if the game is paused, this is separate from the states above
     bool _isPaused;
 
+    // if a GameOverEvent was queued, but not handled yet
+    bool _isGameOverQueued;
+
     // physical world
     std::shared_ptr<b2World> _world;
     const b2Vec2 _GRAVITY;
@@ -270,11 +453,16 @@ private:
     const float _BIRD_DEATH_TIME;
     const int _BIRD_MAX_POOPS; // max number of poops that the bird can do in a row
     const float _POOP_DOWNWARD_VELOCITY; // a new poop will move downward away from the bird
-    float _timeSinceLastPoop; // time elapsed since last poop
+    double _lastPoopTime; // time on the timer wheel at which the bird last pooped
+    TimerWheel::Handle _poopTimer; // stops the bird from pooping once the poop duration is over
+    TimerWheel::Handle _deathTimer; // kills the bird if it doesn't poop within the death time
     int _numPoopsLeft; // number of poops the bird has left
     PhysicalActor* _lastPoop; // pointer to the most recent poop that the bird made; NEVER
                               // DEREFERENCE THIS!! for comparison purposes only
 
+    // requests which haven't been applied yet, in the order they were made
+    std::vector<BirdRequest> _birdRequests;
+
     // how many times the bird has successfully pooped on an NPC
     int _playerScore;
 
@@ -282,13 +470,33 @@ private:
     float _difficulty;
     const int _MAX_DIFFICULTY_TIME; // time at which the difficulty is maximum
 
-    int _lastObstacleSpawned; //index of last obstacle spawned
-
     const float _SPAWN_LOCATION_X; // x-coordinate where things are spawned
     float _rightmostObstacleLocation; // position after which it's safe to spawn
     double _totalTimePassed;
     double _playingTimePassed;
 
+    // NPEs to add after the next resetMap()
+    Course _nextMap;
+
+    // Stretches of the course planned by planCourse(), each relative to the spawn location, in the
+    // order they're spawned. Along with their total length, they're guarded by the mutex; the other
+    // planner variables are only touched by planCourse() and the state transitions.
+    const float _PLAN_AHEAD_METERS; // how far ahead of the spawn location the course is planned
+    std::deque<Course> _plannedCourse;
+    float _plannedLength;
+    std::mutex _plannedCourseMutex;
+    std::deque<Course> _discardedCourse; // <- freed by the planner
+    bool _planForDemo;
+    CourseGenerator _plannerGenerator;
+
+    // generates what's spawned without being planned, and the map that resetMap() sets up
+    CourseGenerator _courseGenerator;
+    CourseGenerator _nextMapGenerator;
+
+    // course file that the planner follows instead of generating the course, if there is one
+    const CourseFile* _courseFile;
+    std::size_t _courseFileIndex; // <- index of the next record to plan
+
     // list of all obstacles except for the ground
     std::list<std::shared_ptr<Obstacle>> _obstacles;
 
@@ -307,6 +515,15 @@ private:
 
     // stores all visible actors -- actors appearing earlier get drawn first
     std::list<PhysicalActor*> _visibleActors;
+
+    // what's skipped of the actors of each type while they're off the screen, and how often
+    struct UpdateStats {
+        std::size_t numUpdates;
+        std::size_t numSkipped;
+    };
+    const float _OFFSCREEN_MARGIN; // <- how far off the screen an actor may still be visible
+    std::map<PhysicalActor::TYPE, OFFSCREEN_POLICY> _offscreenPolicies;
+    std::map<PhysicalActor::TYPE, UpdateStats> _updateStats;
 };
 
 #endif // _GAME_LOGIC_HPP_
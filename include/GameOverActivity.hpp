@@ -35,7 +35,7 @@ public:
 
     void update(const float& timeDelta) override;
 
-    void draw(sf::RenderTarget& target) override;
+    void draw(RenderSnapshot& snapshot) override;
 
 private:
 
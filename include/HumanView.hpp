@@ -1,19 +1,23 @@
 #ifndef _HUMAN_VIEW_HPP_
 #define _HUMAN_VIEW_HPP_
 
+#include <memory>
+
 #include <SFML/Graphics.hpp>
 
 #include "GameLogic.hpp"
 
+#include "RenderSnapshot.hpp"
 #include "EventListener.hpp"
 #include "Event.hpp"
+#include "Resources/SpriteResource.hpp"
 
 
 /**
  * Receives user input to control playable actors via the game logic. Also is resposible for
  * displaying visuals and sound to the user.
  */
-class HumanView : public sf::Drawable {
+class HumanView {
 
 public:
 
@@ -29,9 +33,14 @@ public:
     void update(const float& timeDelta);
 
     /**
-     * Draws all actors.
+     * Draws the background and all actors into the given snapshot.
+     */
+    void draw(RenderSnapshot& snapshot) const;
+
+    /**
+     * Draws only the background into the given snapshot.
      */
-    void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
+    void drawBackground(RenderSnapshot& snapshot) const;
 
 private:
 
@@ -59,6 +68,7 @@ private:
     // all other keys make the bird fly
 
     sf::Sprite _beachBackground; // beach background sprite
+    std::shared_ptr<const SpriteResource> _beachSpriteResource; // keeps the background loaded
 };
 
 #endif // _HUMAN_VIEW_HPP_
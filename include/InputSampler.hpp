@@ -0,0 +1,99 @@
+#ifndef _INPUT_SAMPLER_HPP_
+#define _INPUT_SAMPLER_HPP_
+
+#include <vector>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+
+#include <SFML/Window.hpp>
+
+/**
+ * Samples the state of a few keys on a background thread every millisecond, and remembers when
+ * each of them was pressed and released. The window's events are only polled once per frame, so
+ * this tells when a key event polled from the window actually happened, to within about a
+ * millisecond.
+ * 
+ * Window events still have to be polled as usual; SFML only delivers them to the thread that made
+ * the window. Only the keyboard is sampled, since joysticks are updated by polling window events,
+ * which would race with the sampling thread. On Linux, the keyboard is read through Xlib, so
+ * XInitThreads() has to be called before the window is made.
+ */
+class InputSampler {
+
+public:
+
+    typedef std::chrono::steady_clock Clock;
+
+    InputSampler();
+
+    /**
+     * Stops the sampling thread if it's running.
+     */
+    ~InputSampler();
+
+    /**
+     * Starts sampling the given keys on a background thread.
+     */
+    void start(const std::vector<sf::Keyboard::Key>& keys);
+
+    /**
+     * Stops and joins the sampling thread.
+     */
+    void stop();
+
+    bool isRunning() const { return _thread.joinable(); }
+
+    /**
+     * Pauses or resumes sampling, e.g. so that the sampling thread doesn't keep waking up while the
+     * game waits for input. Keys that change while paused aren't timed.
+     */
+    void setPaused(const bool& paused);
+
+    /**
+     * Looks up when the given key was pressed (or released) to cause an event that was just polled,
+     * and forgets that and everything before it about that key. If the key isn't sampled or the
+     * sampling thread didn't see it change, then the given fallback time is returned instead.
+     * @param wasSampled set to whether the time was found
+     */
+    Clock::time_point takeTime(const sf::Keyboard::Key& key, const bool& pressed,
+            const Clock::time_point& fallback, bool& wasSampled);
+
+private:
+
+    // no copying
+    InputSampler(const InputSampler&);
+    InputSampler& operator=(const InputSampler&);
+
+    /**
+     * Loop run by the sampling thread.
+     */
+    void sampleLoop();
+
+    // a key which was seen changing state
+    struct Transition {
+        sf::Keyboard::Key key;
+        bool pressed;
+        Clock::time_point time;
+    };
+
+    std::vector<sf::Keyboard::Key> _keys;
+
+    // transitions that haven't been taken yet, oldest first; guarded by _mutex
+    std::vector<Transition> _transitions;
+    std::mutex _mutex;
+
+    std::thread _thread;
+    std::atomic<bool> _running;
+
+    // whether sampling is paused; guarded by _mutex, and signalled when it's resumed or stopped
+    bool _paused;
+    std::condition_variable _resumed;
+
+    const std::chrono::microseconds _PERIOD; // time between samples
+    const std::chrono::milliseconds _MAX_AGE; // transitions older than this are forgotten
+};
+
+#endif // _INPUT_SAMPLER_HPP_
@@ -0,0 +1,152 @@
+#ifndef _JOB_SYSTEM_HPP_
+#define _JOB_SYSTEM_HPP_
+
+#include <functional>
+#include <string>
+#include <vector>
+#include <deque>
+#include <map>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <iostream>
+
+/**
+ * Runs a graph of jobs on all cores, once per frame. Jobs are added with add(), each depending on
+ * jobs added before it, and they all run during the next call to run(), each as soon as its
+ * dependencies have finished. Running jobs may add more jobs, which run during the same call.
+ * 
+ * Every thread, including the one calling run(), has its own queue of jobs that are ready to run.
+ * A thread runs the jobs from its own queue newest first, and when that's empty it steals the
+ * oldest job from another thread's queue. A job that becomes ready is queued on the thread that
+ * finished its last dependency. Jobs added with addOnCaller() are never stolen; they wait in a
+ * queue of their own for the thread calling run(), for work that has to stay on that thread,
+ * e.g. because it triggers events or uses OpenGL.
+ * 
+ * The time each job takes is recorded under the job's name, see printStats().
+ */
+class JobSystem {
+
+public:
+
+    /**
+     * Starts the given number of worker threads, in addition to the thread that calls run(). If
+     * numThreads is 0, then one thread is started for every other hardware thread.
+     */
+    JobSystem(unsigned numThreads = 0);
+
+    /**
+     * Stops and joins all worker threads. Must not be called during run().
+     */
+    ~JobSystem();
+
+    /**
+     * Adds a job which calls the given function once all of the given jobs have finished. May be
+     * called from a running job, but the dependencies must be jobs of the same run.
+     * @return the id of the job, which is only valid until run() returns
+     */
+    int add(const std::string& name, const std::function<void()>& function,
+            const std::vector<int>& dependencies = std::vector<int>());
+
+    /**
+     * Same as add(), except that the job only ever runs on the thread calling run().
+     */
+    int addOnCaller(const std::string& name, const std::function<void()>& function,
+            const std::vector<int>& dependencies = std::vector<int>());
+
+    /**
+     * Runs all added jobs, and the jobs they add, then returns. The calling thread runs jobs too.
+     */
+    void run();
+
+    /**
+     * Returns the number of threads that run jobs, including the one calling run().
+     */
+    unsigned getNumThreads() const { return _queues.size(); }
+
+    /**
+     * Writes the collected timings to the given stream as a table, one row per job name.
+     */
+    void printStats(std::ostream& out) const;
+
+private:
+
+    // no copying
+    JobSystem(const JobSystem&);
+    JobSystem& operator=(const JobSystem&);
+
+    struct Job {
+        std::string name;
+        std::function<void()> function;
+        int numWaiting; // number of dependencies which haven't finished yet
+        std::vector<int> dependents; // jobs which are waiting on this one
+        bool onCaller; // only runs on the thread calling run()
+        bool finished;
+        double time; // seconds the function took
+    };
+
+    // jobs which are ready to run on one thread
+    struct Queue {
+        std::deque<int> jobs;
+        std::mutex mutex;
+    };
+
+    struct JobStats {
+        unsigned long numRuns;
+        double totalTime;
+        double maxTime;
+        double lastTime; // total time of all jobs with the name in the last run
+    };
+
+    /**
+     * Adds a job for add() and addOnCaller().
+     */
+    int addJob(const std::string& name, const std::function<void()>& function,
+            const std::vector<int>& dependencies, const bool& onCaller);
+
+    /**
+     * Loop run by every worker thread. Worker threads use queues 1 and up; the thread calling run()
+     * uses queue 0.
+     */
+    void workerLoop(const int& queueIndex);
+
+    /**
+     * Runs one job from the given thread's queue, or stolen from another. The thread calling run()
+     * runs the jobs queued for it first. Returns false if there was no job ready to run.
+     */
+    bool runOne(const int& queueIndex);
+
+    /**
+     * Queues a job which is ready to run on the given thread, and wakes the sleeping threads. Jobs
+     * which only run on the thread calling run() go to its own queue instead, without waking
+     * anyone, since that thread never sleeps during run().
+     */
+    void push(const int& queueIndex, const int& job, const bool& onCaller);
+
+    // worker threads, and one queue per thread that runs jobs
+    std::vector<std::thread> _threads;
+    std::vector<std::unique_ptr<Queue>> _queues;
+    Queue _callerQueue; // jobs which only run on the thread calling run()
+
+    // Jobs of the current run, indexed by id. A deque, so that running jobs keep their addresses
+    // when more are added. Guarded by _graphMutex, along with the bookkeeping in every job.
+    std::deque<Job> _jobs;
+    std::vector<int> _readyJobs; // jobs which were ready before run() was called
+    bool _running;
+    std::mutex _graphMutex;
+
+    std::atomic<int> _numUnfinished; // jobs of the current run which haven't finished
+    std::atomic<int> _numQueued; // jobs sitting in queues that can be stolen
+
+    // worker threads sleep on this when there's nothing to run
+    bool _stopping;
+    std::mutex _wakeMutex;
+    std::condition_variable _wakeCondition;
+
+    unsigned long _numRuns;
+    std::map<std::string, JobStats> _stats;
+};
+
+#endif // _JOB_SYSTEM_HPP_
@@ -0,0 +1,42 @@
+#ifndef _LOADING_ACTIVITY_HPP_
+#define _LOADING_ACTIVITY_HPP_
+
+#include <SFML/Graphics.hpp>
+
+#include "Activity.hpp"
+
+/**
+ * Shown while the resource cache is loading resources in the background. Displays a progress bar
+ * and a spinning square. Doesn't use any resources from the resource cache, since they might not be
+ * loaded yet.
+ */
+class LoadingActivity : public Activity {
+
+public:
+
+    LoadingActivity();
+
+    void init();
+
+    /**
+     * Updates the progress bar to the resource cache's loading progress and spins the square.
+     */
+    void update(const float& timeDelta) override;
+
+    void draw(RenderSnapshot& snapshot) override;
+
+private:
+
+    bool _initialized;
+
+    // progress bar, the fill grows to the right as resources get loaded
+    sf::RectangleShape _progressBar;
+    sf::RectangleShape _progressOutline;
+    const sf::Vector2f _PROGRESS_BAR_SIZE;
+
+    // spins so that it's obvious the game isn't frozen
+    sf::RectangleShape _spinner;
+    const float _SPIN_SPEED; // degrees per second
+};
+
+#endif // _LOADING_ACTIVITY_HPP_
@@ -3,6 +3,7 @@
 
 #include <functional>
 #include <list>
+#include <memory>
 
 #include <SFML/Graphics.hpp>
 
@@ -11,6 +12,7 @@
 #include "ButtonManager.hpp"
 #include "Event.hpp"
 #include "EventListener.hpp"
+#include "Resources/SpriteResource.hpp"
 
 /**
  * Subactivity of PlayingActivity. Displays and controls the main menu user interface.
@@ -41,7 +43,7 @@ public:
 
     void update(const float& timeDelta) override;
 
-    void draw(sf::RenderTarget& target) override;
+    void draw(RenderSnapshot& snapshot) override;
 
 private:
 
@@ -59,7 +61,8 @@ private:
     // super activity
     class PlayingActivity* _playingActivity;
 
-    // logo
+    // logo, the resource is held to keep its texture loaded
+    std::shared_ptr<const SpriteResource> _logoSpriteResource;
     sf::Sprite _logo;
 
     // buttons
@@ -0,0 +1,60 @@
+#ifndef _MAPPED_FILE_HPP_
+#define _MAPPED_FILE_HPP_
+
+#include <cstddef>
+#include <string>
+
+/**
+ * A read-only view of a whole file which is mapped into memory. Pages are loaded by the OS as they
+ * are touched, so opening even a large file is cheap. Uses mmap on POSIX systems and file mappings
+ * on Windows.
+ */
+class MappedFile {
+
+public:
+
+    MappedFile();
+
+    /**
+     * Unmaps the file if it's open.
+     */
+    ~MappedFile();
+
+    // a mapping can't be shared between two owners
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /**
+     * Maps the file with the given filename into memory. Any previously opened file is closed.
+     * @return true if the file was mapped, false otherwise
+     */
+    bool open(const std::string& filename);
+
+    /**
+     * Unmaps the file. Any pointers returned by getData() are invalid after this.
+     */
+    void close();
+
+    bool isOpen() const { return _data != nullptr; }
+
+    /**
+     * Returns the start of the mapped file, or nullptr if no file is open.
+     */
+    const unsigned char* getData() const { return _data; }
+
+    /**
+     * Returns the size of the mapped file in bytes.
+     */
+    std::size_t getSize() const { return _size; }
+
+private:
+
+    const unsigned char* _data;
+    std::size_t _size;
+
+    // handles of the open file and its mapping, only Windows needs the mapping handle
+    void* _fileHandle;
+    void* _mappingHandle;
+};
+
+#endif // _MAPPED_FILE_HPP_
@@ -1,12 +1,15 @@
 #ifndef _NPC_HPP_
 #define _NPC_HPP_
 
+#include <memory>
 #include <vector>
 
 #include <SFML/Graphics.hpp>
 
 #include "PhysicalActor.hpp"
+#include "TimerWheel.hpp"
 #include "Resources/SpriteResource.hpp"
+#include "Resources/PolygonResource.hpp"
 
 /**
  * Parent Class of The NPC people that serve as targets and enemies to the bird. Currently there are
@@ -32,11 +35,21 @@ public:
         FINISH_THROW
     };
 
-    //Override update method
-    void update(const float& timeDelta) override;
-
     //Override draw method
-    void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
+    void draw(RenderSnapshot& snapshot, const sf::RenderStates& states) const override;
+
+    /**
+     * Sets the timer wheel which times the NPC's actions and animation, which must be set before
+     * the NPC is told to do anything. Setting it to nullptr cancels the NPC's timers; this has to
+     * be done before the NPC or the wheel is destroyed, since the timers refer to the NPC.
+     */
+    void setTimerWheel(TimerWheel* timers);
+
+    /**
+     * Pauses or resumes the NPC's animation, e.g. while the NPC is off the screen. A resumed
+     * animation picks up at the frame it would have reached if it had never been paused.
+     */
+    void setAnimated(const bool& animated);
 
     /**
      * Does the specified action after the given delay in seconds has passed. The action will last
@@ -71,9 +84,11 @@ public:
 
 private:
 
-    // Constructor and initializer are private so that only the NPCFactory is able to make NPCs
+    // Constructor and initializer are private so that only the NPCFactory is able to make NPCs. The
+    // factory passes in the sprite of the NPC's type and the body hitbox.
     NPC(const NPC::TYPE& type);
-    void init();
+    void init(const std::shared_ptr<const SpriteResource>& spriteResource,
+            const PolygonResource& bodyHitbox);
 
     /**
      * Walks for the given duration in seconds, in the direction given by walkLeft. Once the NPC has
@@ -99,10 +114,39 @@ private:
      */
     void toIdle();
 
+    /**
+     * Starts the animation made up of the given frames, at the given frame.
+     */
+    void startAnimation(const float& frameDuration, const int& startFrame, const int& numFrames,
+            const int& currentFrame);
+
+    /**
+     * Shows the frame that the animation has reached by now, and schedules the next one.
+     */
+    void syncAnimation();
+
+    /**
+     * Called by the frame timer to move on to the next frame of the animation. Loops the animation
+     * only if the NPC isn't starting to throw.
+     */
+    void advanceFrame();
+
+    /**
+     * Called by the action timer once the current action's duration has passed.
+     */
+    void finishAction();
+
+    /**
+     * Called by the prepare timer to do the next action once its delay has passed.
+     */
+    void startNextAction();
+
     const TYPE _TYPE;
 
     bool _initialized;
 
+    // the sprite resource is held so that its texture stays loaded
+    std::shared_ptr<const SpriteResource> _spriteResource;
     sf::Sprite _sprite;
     std::vector<sf::IntRect> _textureRects;
 
@@ -135,15 +179,21 @@ private:
     int _startFrame;
     int _numFrames;
     int _currentFrame;
-    float _frameTimer;
+    int _firstFrame;             // frame that the animation started at
+    double _animationStartTime;  // time on the timer wheel at which the animation started
+    bool _isAnimated;
 
     // state stuff
     bool _isFacingLeft;
     bool _isReadyToFinishThrowing;
-    float _actionTimeRemaining;
-    float _prepareTimeRemaining;
     ACTION _nextAction;
     float _nextActionDuration;
+
+    // timers for the next frame, the end of the current action, and the start of the next action
+    TimerWheel* _timers;
+    TimerWheel::Handle _frameTimer;
+    TimerWheel::Handle _actionTimer;
+    TimerWheel::Handle _prepareTimer;
 };
 
 #endif
\ No newline at end of file
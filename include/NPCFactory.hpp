@@ -4,6 +4,9 @@
 #include <memory>
 
 #include "NPC.hpp"
+#include "ResourceHandle.hpp"
+#include "Resources/SpriteResource.hpp"
+#include "Resources/PolygonResource.hpp"
 
 class NPCFactory {
 
@@ -11,9 +14,21 @@ public:
 
     NPCFactory() {}
 
+    /**
+     * Resolves the handles of all resources that the factory uses. Must be called after the
+     * resource cache has started loading, and before any NPCs are made.
+     */
+    static void init();
+
     static std::shared_ptr<NPC> makeMale();
 
     static std::shared_ptr<NPC> makeFemale();
+
+private:
+
+    static ResourceHandle<SpriteResource> _maleSprite;
+    static ResourceHandle<SpriteResource> _femaleSprite;
+    static ResourceHandle<PolygonResource> _bodyHitbox;
 };
 
 #endif // _NPC_FACTORY_HPP_
\ No newline at end of file
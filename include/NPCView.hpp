@@ -1,6 +1,10 @@
 #ifndef _NPC_VIEW_HPP_
 #define _NPC_VIEW_HPP_
 
+#include <vector>
+#include <memory>
+#include <cstddef>
+
 #include <SFML/Graphics.hpp>
 
 #include "GameLogic.hpp"
@@ -12,6 +16,10 @@
 /**
  * Controls the NPCs. Will make them walk around and throw objects at the bird. The NPCs will throw
  * objects more frequently as the logic's difficulty increases.
+ * 
+ * What the NPCs do next is decided in two steps: decide() only reads the logic, so that the NPCs
+ * can be split into ranges which are decided in parallel, and act() then requests the decided
+ * actions from the logic.
  */
 class NPCView {
 
@@ -21,14 +29,41 @@ public:
 
     void init(GameLogic& logic);
 
-    void update(const float& timeDelta);
+    /**
+     * Takes the logic's current NPCs to decide for.
+     * @return the number of NPCs, which decide() indexes
+     */
+    std::size_t startDeciding();
+
+    /**
+     * Decides what the NPCs in [begin, end) do next, without changing the logic or the NPCs.
+     * Different ranges may be decided at the same time.
+     */
+    void decide(const std::size_t& begin, const std::size_t& end);
+
+    /**
+     * Requests the decided actions from the logic.
+     */
+    void act();
 
 private:
 
+    // what an NPC was decided to do; IDLE if nothing
+    struct Decision {
+        NPC::ACTION action;
+        float delay;
+        float duration;
+        bool faceLeft;
+    };
+
     bool _initialized;
 
     GameLogic* _logic;
 
+    // the NPCs being decided for, and what was decided for each of them
+    std::vector<std::shared_ptr<NPC>> _npcs;
+    std::vector<Decision> _decisions;
+
     // difficulty settings
     const float _EASY_THROW_CHANCE;
     const float _HARD_THROW_CHANCE;
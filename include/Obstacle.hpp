@@ -3,6 +3,7 @@
 
 #include <cassert>
 #include <list>
+#include <memory>
 
 #include <SFML/Graphics.hpp>
 #include <box2d/box2d.h>
@@ -21,7 +22,7 @@ class Obstacle : public PhysicalActor {
 
 public:
 
-    void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
+    void draw(RenderSnapshot& snapshot, const sf::RenderStates& states) const override;
 
     // only the ObstacleFactory is able to create Obstacles
     friend class ObstacleFactory;
@@ -33,21 +34,24 @@ private:
      * 
      * @param type the type of PhysicalActor -- normally this is just GENERIC_OBSTACLE, but some
      *             obstacles are special, e.g. the poop obstacle
-     * @param texture texture of the obstacle
+     * @param spriteResource sprite whose texture is used by the obstacle, which is kept loaded for
+     *                       as long as the obstacle exists
      * @param scale added components will be scaled by this amount
      */
-    Obstacle(const PhysicalActor::TYPE& type, const sf::Texture& texture,
-            const sf::Vector2f& scale);
+    Obstacle(const PhysicalActor::TYPE& type,
+            const std::shared_ptr<const SpriteResource>& spriteResource, const sf::Vector2f& scale);
 
     /**
      * Creates an Obstacle.
      * 
      * @param type the type of PhysicalActor -- normally this is just GENERIC_OBSTACLE, but some
      *             obstacles are special, e.g. the poop obstacle
-     * @param texture texture of the obstacle
+     * @param spriteResource sprite whose texture is used by the obstacle, which is kept loaded for
+     *                       as long as the obstacle exists
      * @param scale added components will be scaled by this amount
      */
-    Obstacle(const PhysicalActor::TYPE& type, const sf::Texture& texture, const float& scaleFactor);
+    Obstacle(const PhysicalActor::TYPE& type,
+            const std::shared_ptr<const SpriteResource>& spriteResource, const float& scaleFactor);
 
     /**
      * Adds a component to the obstacle. A component has a visual component, denoted by a texture
@@ -62,6 +66,7 @@ private:
     void addComponent(const sf::IntRect& textureRect, const b2FixtureDef& fixtureDef,
             std::list<b2PolygonShape> polygons, const sf::Vector2f& translation);
 
+    const std::shared_ptr<const SpriteResource> _SPRITE_RESOURCE;
     const sf::Texture& _TEXTURE;
     const sf::Vector2f _SCALE;
     sf::VertexArray _vertices;
@@ -2,6 +2,9 @@
 #define _OBSTACLE_FACTORY_HPP_
 
 #include "Obstacle.hpp"
+#include "ResourceHandle.hpp"
+#include "Resources/SpriteResource.hpp"
+#include "Resources/PolygonResource.hpp"
 
 class ObstacleFactory {
 
@@ -9,6 +12,13 @@ public:
 
     ObstacleFactory() {}
 
+    /**
+     * Resolves the handles of all resources that the factory uses, so that making an obstacle
+     * doesn't need to look anything up by id. Must be called after the resource cache has started
+     * loading, and before any obstacles are made.
+     */
+    static void init();
+
     /**
      * Creates and returns a streetlight obstacle whose height as close as possible to (but not
      * above) to the given height in meters. faceLeft denotes whether the streetlight is facing left
@@ -49,6 +59,37 @@ public:
     static std::shared_ptr<Obstacle> makeRock();
     
     static std::shared_ptr<Obstacle> makeBeachBall(float tAngle);
+
+private:
+
+    // sprites
+    static ResourceHandle<SpriteResource> _streetlightSprite;
+    static ResourceHandle<SpriteResource> _groundSprite;
+    static ResourceHandle<SpriteResource> _bigGroundSprite;
+    static ResourceHandle<SpriteResource> _poopSprite;
+    static ResourceHandle<SpriteResource> _splatterSprite;
+    static ResourceHandle<SpriteResource> _treeSprite;
+    static ResourceHandle<SpriteResource> _cloudSprite;
+    static ResourceHandle<SpriteResource> _docksSprite;
+    static ResourceHandle<SpriteResource> _lifeguardSprite;
+    static ResourceHandle<SpriteResource> _rockSprite;
+    static ResourceHandle<SpriteResource> _umbrellaSprite;
+
+    // hitboxes
+    static ResourceHandle<PolygonResource> _fullHitbox;
+    static ResourceHandle<PolygonResource> _octagonHitbox;
+    static ResourceHandle<PolygonResource> _slantedHitbox;
+    static ResourceHandle<PolygonResource> _streetlightBaseHitbox;
+    static ResourceHandle<PolygonResource> _streetlightTopHitbox1;
+    static ResourceHandle<PolygonResource> _streetlightTopHitbox2;
+    static ResourceHandle<PolygonResource> _streetlightTopHitbox3;
+    static ResourceHandle<PolygonResource> _splatterHitbox;
+    static ResourceHandle<PolygonResource> _treetopHitbox;
+    static ResourceHandle<PolygonResource> _cloudHitbox;
+    static ResourceHandle<PolygonResource> _lifeguardRampHitbox;
+    static ResourceHandle<PolygonResource> _lifeguardPlatformHitbox;
+    static ResourceHandle<PolygonResource> _lifeguardBuildingHitbox;
+    static ResourceHandle<PolygonResource> _umbrellaHitbox;
 };
 
 #endif // _OBSTACLE_FACTORY_HPP_
@@ -65,8 +65,13 @@ public:
     /**
      * Returns the type represented as a string, used only for debug output.
      */
-    std::string getTypeStr() const {
-        switch (_TYPE) {
+    std::string getTypeStr() const { return getTypeStr(_TYPE); }
+
+    /**
+     * Returns the given type represented as a string, used only for debug output.
+     */
+    static std::string getTypeStr(const PhysicalActor::TYPE& type) {
+        switch (type) {
         case TYPE::GENERIC_OBSTACLE: return "GENERIC_OBSTACLE";
         case TYPE::GROUND:           return "GROUND";
         case TYPE::NPC:              return "NPC";
@@ -1,11 +1,13 @@
 #ifndef _PLAYABLE_BIRD_HPP_
 #define _PLAYABLE_BIRD_HPP_
 
+#include <memory>
 #include <vector>
 
 #include <SFML/Graphics.hpp>
 
 #include "PhysicalActor.hpp"
+#include "TimerWheel.hpp"
 #include "Resources/SpriteResource.hpp"
 
 /**
@@ -22,9 +24,13 @@ public:
      */
     void init();
 
-    void update(const float& timeDelta) override;
+    /**
+     * Sets the timer wheel which times the flying animation. Setting it to nullptr cancels the
+     * animation's timer; this has to be done before the wheel is destroyed while the bird flies.
+     */
+    void setTimerWheel(TimerWheel* timers);
 
-    void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
+    void draw(RenderSnapshot& snapshot, const sf::RenderStates& states) const override;
 
     /**
      * Methods which are called by the game logic to cause various behavior in the bird. These
@@ -42,9 +48,20 @@ public:
 
 private:
 
+    /**
+     * Called by the frame timer to move on to the next frame of the flying sequence.
+     */
+    void advanceFrame();
+
+    /**
+     * Sets the texture rectangle to the current frame, unless the bird is dead.
+     */
+    void updateTextureRect();
+
     bool _initialized;
 
-    // sprite to be used and its texture rectangles
+    // sprite to be used and its texture rectangles, the resource is held to keep its texture loaded
+    std::shared_ptr<const SpriteResource> _spriteResource;
     sf::Sprite _sprite;
     std::vector<sf::IntRect> _textureRects;
 
@@ -55,7 +72,8 @@ private:
     const int _FALLING_FRAME;              // relative frame to display when bird is falling
     const float _FLYING_FRAME_DURATION;    // duration of one frame of flying
     int _currentFlyingFrame; // an index in the _FLYING_FRAMES vector
-    float _frameTimer; // keeps track of when to advance the frame for flying
+    TimerWheel* _timers;
+    TimerWheel::Handle _frameTimer; // advances the frame while flying
 
     // whether the bird is flying/pooping/dead
     bool _isFlying;
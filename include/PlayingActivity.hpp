@@ -1,6 +1,8 @@
 #ifndef _PLAYING_ACTIVITY_HPP_
 #define _PLAYING_ACTIVITY_HPP_
 
+#include <iostream>
+
 #include <SFML/Graphics.hpp>
 
 #include "Activity.hpp"
@@ -12,6 +14,9 @@
 #include "PlayingMenuActivity.hpp"
 #include "GameOverActivity.hpp"
 #include "EventListener.hpp"
+#include "JobSystem.hpp"
+#include "DemoRecording.hpp"
+#include "CourseFile.hpp"
 
 /**
  * The PlayingActivity is the core activity which is run by the game. It contains sub-activities
@@ -26,16 +31,35 @@ public:
     ~PlayingActivity();
 
     /**
-     * Initializes with a render target.
+     * Initializes with the job system which runs the updates.
+     */
+    void init(JobSystem& jobSystem);
+
+    /**
+     * Sets the course file which the logic takes the course from while playing, see
+     * GameLogic::setCourseFile().
      */
-    void init(sf::RenderTarget& target);
+    void setCourseFile(const CourseFile* courseFile);
 
     /**
-     * Updates views and then game logic.
+     * Writes how many updates of off-screen actors the logic skipped, see
+     * GameLogic::printUpdateStats().
+     */
+    void printUpdateStats(std::ostream& out) const;
+
+    /**
+     * Updates views and then game logic, as jobs of the job system: the NPCs' decisions and the
+     * course planning run in parallel, the logic itself on the calling thread. Then updates the
+     * current subactivity.
      */
     void update(const float& timeDelta) override;
 
-    void draw(sf::RenderTarget& target) override;
+    void draw(RenderSnapshot& snapshot) override;
+
+    /**
+     * Returns true if the game is paused.
+     */
+    bool isPaused() const;
 
     /**
      * Methods to transition to different subactivities. These also affect the state of the logic.
@@ -46,7 +70,28 @@ public:
 
 private:
 
+    /**
+     * Returns true if the main menu is up and the demo behind it is played back from its recording
+     * rather than simulated.
+     */
+    bool isPlayingBackDemo() const;
+
+    /**
+     * Returns true if the demo behind the main menu can be recorded, which it can't if textures
+     * may be evicted while the recording refers to them.
+     */
+    bool canRecordDemo() const;
+
+    /**
+     * Returns how far the screen is faded to black, from 0 to 1. The recorded demo is looped by
+     * fading out at its end and in at its start, and a game which is started from the recording
+     * fades in, since the world is reset rather than where the recording was.
+     */
+    float getFade() const;
+
     bool _initialized;
+
+    JobSystem* _jobSystem;
     
     // event listener
     EventListener _gameOverListener;
@@ -58,6 +103,16 @@ private:
     HumanView _humanView;
     NPCView _npcView;
 
+    // The first _DEMO_LENGTH seconds of the demo behind the main menu are recorded while it's
+    // simulated, after which the recording is played back in a loop instead.
+    DemoRecording _demoRecording;
+    float _demoTime; // seconds since the demo started
+    const float _DEMO_LENGTH;
+
+    // fading through black, see getFade()
+    float _fadeInTime; // seconds left of fading in a game that was started from the recording
+    const float _FADE_DURATION;
+
     // PlayingActivity has activities of its own, these act as user interfaces
     MainMenuActivity _mainMenuActivity;
     PlayingMenuActivity _playingMenuActivity;
@@ -2,6 +2,7 @@
 #define _PLAYING_MENU_ACTIVITY_HPP_
 
 #include <list>
+#include <memory>
 #include <vector>
 
 #include <SFML/Graphics.hpp>
@@ -12,6 +13,7 @@
 #include "ButtonManager.hpp"
 #include "EventListener.hpp"
 #include "Event.hpp"
+#include "Resources/SpriteResource.hpp"
 
 /**
  * Subactivity of PlayingActivity. Displays the score, number of poops left, and handles buttons
@@ -44,7 +46,7 @@ public:
 
     void update(const float& timeDelta) override;
 
-    void draw(sf::RenderTarget& target) override;
+    void draw(RenderSnapshot& snapshot) override;
 
 private:
 
@@ -72,6 +74,7 @@ private:
     const GameLogic* _logic;
 
     // indicators -- the top one is for the first poop, the bottom for the second
+    std::shared_ptr<const SpriteResource> _indicatorSpriteResource; // keeps the texture loaded
     sf::Sprite _topPoopIndicator;
     sf::Sprite _bottomPoopIndicator;
     std::vector<sf::IntRect> _indicatorRects;
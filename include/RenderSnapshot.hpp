@@ -0,0 +1,93 @@
+#ifndef _RENDER_SNAPSHOT_HPP_
+#define _RENDER_SNAPSHOT_HPP_
+
+#include <vector>
+
+#include <SFML/Graphics.hpp>
+
+/**
+ * Everything that is drawn in one frame. Activities record their drawables into a snapshot instead
+ * of drawing them onto the window, and the snapshot is drawn afterwards, possibly by another thread
+ * while the next frame is already being simulated. Each drawable is copied along with its render
+ * states, so the snapshot doesn't change when the actors it was recorded from do. The copies still
+ * point to their textures and fonts, which must stay loaded until the snapshot has been drawn.
+ *
+ * The copies are kept in one vector per drawable type, which keep their capacity when the snapshot
+ * is cleared. Sprites, rectangles and circles are copied without allocating once the vectors have
+ * grown, but copies of text, convex shapes and vertex arrays still allocate for their vertices.
+ * Text is laid out before it's copied, so the copy never touches its font while it's drawn.
+ */
+class RenderSnapshot {
+
+public:
+
+    RenderSnapshot();
+
+    /**
+     * Removes all recorded drawables.
+     */
+    void clear();
+
+    /**
+     * Sets and gets the view that the snapshot is drawn with.
+     */
+    void setView(const sf::View& view);
+    const sf::View& getView() const;
+
+    /**
+     * Records a copy of the given drawable, drawn with the given render states after everything
+     * that was recorded before it.
+     */
+    void add(const sf::Sprite& sprite, const sf::RenderStates& states = sf::RenderStates::Default);
+    void add(const sf::Text& text, const sf::RenderStates& states = sf::RenderStates::Default);
+    void add(const sf::RectangleShape& rectangle,
+            const sf::RenderStates& states = sf::RenderStates::Default);
+    void add(const sf::CircleShape& circle,
+            const sf::RenderStates& states = sf::RenderStates::Default);
+    void add(const sf::ConvexShape& polygon,
+            const sf::RenderStates& states = sf::RenderStates::Default);
+    void add(const sf::VertexArray& vertices,
+            const sf::RenderStates& states = sf::RenderStates::Default);
+
+    /**
+     * Records everything recorded in the other snapshot, transformed by the given render states.
+     */
+    void add(const RenderSnapshot& other, const sf::RenderStates& states = sf::RenderStates::Default);
+
+    /**
+     * Returns true if the other snapshot has the same sprites and vertex arrays, drawn the same way
+     * in the same order, as this one. Snapshots with any other drawables are never considered the
+     * same, since comparing them isn't worth it.
+     */
+    bool isSameAs(const RenderSnapshot& other) const;
+
+    /**
+     * Sets the target's view to the snapshot's view and draws everything in the order it was
+     * recorded. Doesn't clear or display the target.
+     */
+    void draw(sf::RenderTarget& target) const;
+
+private:
+
+    enum TYPE {SPRITE, TEXT, RECTANGLE, CIRCLE, CONVEX, VERTICES};
+
+    // one recorded draw call; index refers to the vector of the given type
+    struct Command {
+        TYPE type;
+        std::size_t index;
+        sf::RenderStates states;
+    };
+
+    sf::View _view;
+
+    std::vector<Command> _commands;
+
+    std::vector<sf::Sprite> _sprites;
+    std::vector<sf::Text> _texts;
+    std::vector<sf::RectangleShape> _rectangles;
+    std::vector<sf::CircleShape> _circles;
+    std::vector<sf::ConvexShape> _polygons;
+    std::vector<sf::VertexArray> _vertexArrays;
+};
+
+#endif // _RENDER_SNAPSHOT_HPP_
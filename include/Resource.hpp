@@ -1,11 +1,16 @@
 #ifndef _RESOURCE_HPP_
 #define _RESOURCE_HPP_
 
+#include <cstddef>
+
 typedef void* ResourceType;
 
 /**
  * Superclass for all resources (SpriteResource, TextureResource, etc.). This exists just so that
  * type checking can be done when accessing a resource from the resource cache.
+ * 
+ * Resources are built in place by the resource cache and are never copied, since copying e.g. a
+ * texture means reading it back from the GPU and uploading it again.
  */
 class Resource {
 
@@ -14,6 +19,27 @@ public:
     virtual ~Resource() {}
 
     virtual const ResourceType& getType() const = 0;
+
+    /**
+     * Returns how many bytes of main memory the resource takes up, including what it points to
+     * which isn't shared with other resources.
+     */
+    virtual std::size_t getCpuBytes() const = 0;
+
+    /**
+     * Returns how many bytes of GPU memory the resource takes up, e.g. the pixels of a texture.
+     */
+    virtual std::size_t getGpuBytes() const { return 0; }
+
+protected:
+
+    Resource() {}
+
+private:
+
+    // resources can't be copied
+    Resource(const Resource&);
+    Resource& operator=(const Resource&);
 };
 
 #endif // _RESOURCE_HPP_
@@ -0,0 +1,88 @@
+#ifndef _RESOURCE_ARCHIVE_HPP_
+#define _RESOURCE_ARCHIVE_HPP_
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
+#include "MappedFile.hpp"
+
+/**
+ * One entry in the index of a resource archive. The data of the entry lives at `offset` bytes from
+ * the start of the archive and is `size` bytes long.
+ * - TEXTURE: raw RGBA pixels, width * height * 4 bytes
+ * - FONT: the unmodified font file
+ */
+struct ResourceArchiveEntry {
+
+    enum TYPE : std::uint32_t {TEXTURE, FONT};
+
+    char id[48]; // null terminated
+    std::uint32_t type;
+    std::uint32_t width;
+    std::uint32_t height;
+    std::uint32_t padding;
+    std::uint64_t offset;
+    std::uint64_t size;
+};
+
+static_assert(sizeof(ResourceArchiveEntry) == 80, "archive entries must be 80 bytes");
+
+/**
+ * Read-only access to an archive of pre-processed resources, as written by ResourceArchiveWriter.
+ * The archive is memory mapped, so the data returned by getData() points straight into the file
+ * and stays valid until the archive is closed.
+ * 
+ * Layout: a header ("GBRA", version, number of entries, padding; all uint32 except the magic;
+ * then the uint64 hash of the manifest that the archive was packed from, see
+ * ResourceManifest::getArchiveHash()), followed by the entries, followed by the data of each entry
+ * aligned to DATA_ALIGNMENT bytes.
+ * Everything is stored in the native byte order, since the archive is built alongside the game.
+ */
+class ResourceArchive {
+
+public:
+
+    ResourceArchive() : _manifestHash(0) {}
+
+    /**
+     * Maps the archive with the given filename and reads its index. Fails if the file doesn't
+     * exist or isn't a valid archive of the current version.
+     * @return true if the archive was opened, false otherwise
+     */
+    bool open(const std::string& filename);
+
+    void close();
+
+    bool isOpen() const { return _file.isOpen(); }
+
+    std::uint64_t getManifestHash() const { return _manifestHash; }
+
+    /**
+     * Returns the entry with the given id and type, or nullptr if the archive doesn't have one.
+     */
+    const ResourceArchiveEntry* find(const std::string& id,
+            const ResourceArchiveEntry::TYPE& type) const;
+
+    /**
+     * Returns a pointer to the data of the given entry, which must come from this archive.
+     */
+    const unsigned char* getData(const ResourceArchiveEntry& entry) const {
+        return _file.getData() + entry.offset;
+    }
+
+    static const char MAGIC[4];
+    static const std::uint32_t VERSION = 3;
+    static const std::uint32_t HEADER_SIZE = 24;
+    static const std::uint32_t DATA_ALIGNMENT = 16;
+
+private:
+
+    MappedFile _file;
+    std::uint64_t _manifestHash;
+
+    // maps ids to their entries, which point into the mapped file
+    std::unordered_map<std::string, const ResourceArchiveEntry*> _entries;
+};
+
+#endif // _RESOURCE_ARCHIVE_HPP_
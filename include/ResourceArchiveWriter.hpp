@@ -0,0 +1,60 @@
+#ifndef _RESOURCE_ARCHIVE_WRITER_HPP_
+#define _RESOURCE_ARCHIVE_WRITER_HPP_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <SFML/Graphics.hpp>
+
+#include "ResourceArchive.hpp"
+
+/**
+ * Collects resources in memory and writes them out as a resource archive which can be read by
+ * ResourceArchive. Used by the pack_resources tool at build time.
+ */
+class ResourceArchiveWriter {
+
+public:
+
+    ResourceArchiveWriter() : _manifestHash(0) {}
+
+    /**
+     * Sets the hash of the manifest that the resources come from, which is stored in the archive.
+     */
+    void setManifestHash(const std::uint64_t& hash) { _manifestHash = hash; }
+
+    /**
+     * Adds the pixels of the given image as a texture.
+     */
+    void addTexture(const std::string& id, const sf::Image& image);
+
+    /**
+     * Adds the contents of the font file with the given filename.
+     * @return true if the file could be read, false otherwise
+     */
+    bool addFont(const std::string& id, const std::string& filename);
+
+    /**
+     * Writes all the added resources to an archive with the given filename.
+     * @return true if the archive was written, false otherwise
+     */
+    bool write(const std::string& filename) const;
+
+    int getNumEntries() const { return _entries.size(); }
+
+private:
+
+    /**
+     * Adds an entry with the given data. The entry's offset is filled in when it's written.
+     */
+    void addEntry(const std::string& id, const ResourceArchiveEntry::TYPE& type,
+            const unsigned int& width, const unsigned int& height, const void* data,
+            const std::size_t& size);
+
+    std::vector<ResourceArchiveEntry> _entries;
+    std::vector<std::vector<char>> _data; // data of each entry, same order as _entries
+    std::uint64_t _manifestHash;
+};
+
+#endif // _RESOURCE_ARCHIVE_WRITER_HPP_
@@ -6,17 +6,43 @@
 #include <cassert>
 #include <string>
 #include <vector>
+#include <mutex>
+#include <condition_variable>
+#include <ostream>
 
 #include <SFML/Graphics.hpp>
 #include <box2d/box2d.h>
 
 #include "Resource.hpp"
+#include "ResourceId.hpp"
+#include "ResourceHandle.hpp"
 #include "Resources/TextureResource.hpp"
+#include "Resources/FontResource.hpp"
+#include "WorkerPool.hpp"
+#include "ResourceArchive.hpp"
+#include "ResourceArchiveWriter.hpp"
+#include "ResourceManifest.hpp"
 
 /**
  * Stores game resources, e.g. textures, fonts, etc. These resources can be accessed via a unique
- * string ID. As of now, all game resources are loaded into memory; we can change this later if we
- * end up having too many resources.
+ * string ID.
+ * 
+ * Resources can be loaded either all at once with init(), or in the background with
+ * startLoading() and finishLoading(). When loading in the background, images and fonts are decoded
+ * by worker threads, and the decoded images are uploaded as textures by the main thread (which
+ * owns the OpenGL context) a few at a time.
+ * 
+ * If a resource archive is opened first, then textures, fonts and polygons are taken straight
+ * from the memory mapped archive instead, and nothing has to be decoded.
+ * 
+ * With lazy loading, textures and sprites aren't loaded up front at all, but the first time they're
+ * gotten. Textures count against a texture memory budget; once per frame, collectGarbage() evicts
+ * the least recently used textures that nobody holds with acquire() until the cache is within the
+ * budget. Evicted textures are loaded again the next time they're gotten.
+ * 
+ * Once everything is loaded, the cache can be frozen with freeze(). A frozen cache never changes
+ * again, so any number of threads (e.g. several concurrent simulations) can get and acquire
+ * resources from it at the same time without locking.
  */
 class ResourceCache {
 
@@ -33,14 +59,123 @@ public:
     ~ResourceCache();
 
     /**
-     * Stores all resources.
+     * Loads the manifest with the given filename, which describes every resource that gets loaded.
+     * It may be a binary manifest or a text one. Must be called before init(), startLoading() or
+     * pack().
+     * @return true if the manifest was loaded, false otherwise
+     */
+    bool openManifest(const std::string& filename);
+
+    /**
+     * Opens the resource archive with the given filename, from which resources are loaded if it
+     * has them. Must be called after openManifest(), and before init() or startLoading(). Resources
+     * which aren't in the archive are still loaded from their own files. An archive which was
+     * packed from a different manifest isn't used at all.
+     * @return true if the archive was opened, false otherwise
+     */
+    bool openArchive(const std::string& filename);
+
+    /**
+     * If lazy is true, then textures and sprites are only loaded once they're first gotten, instead
+     * of by init() or startLoading(). Fonts and polygons are small and are always loaded up front.
+     * Must be called before init() or startLoading().
+     */
+    void setLazyLoading(const bool& lazy);
+
+    bool isLazyLoading() const { return _lazyLoading; }
+
+    /**
+     * Sets the max amount of texture memory in bytes, which collectGarbage() tries to stay within.
+     * 0 means that there's no budget, which is the default.
+     */
+    void setTextureBudget(const std::size_t& bytes);
+
+    std::size_t getTextureBudget() const { return _textureBudget; }
+
+    /**
+     * Sets how many worker threads decode images and fonts while loading. 0 means one for every
+     * hardware thread except the main thread's, which is the default. Must be called before init()
+     * or startLoading().
+     */
+    void setLoaderThreads(const unsigned& numThreads);
+
+    /**
+     * Decodes every texture and reads every font in the manifest, and adds them to the given writer
+     * instead of storing them. Doesn't need an OpenGL context. Used by the
+     * pack_resources tool; the cache can't be used for anything else afterward.
+     * @return true if all files were read, false otherwise
+     */
+    bool pack(ResourceArchiveWriter& writer);
+
+    /**
+     * Loads and stores all resources, and doesn't return until they're all loaded. All images and
+     * fonts are decoded in parallel by the worker threads first, and then the images are uploaded
+     * as textures in one pass.
      */
     void init();
 
     /**
-     * Returns a pointer to the resource which has the specified id. The given id must be a resource
-     * that has already been stored. Template parameter T describes the type to which the resource
-     * is cast before being returned.
+     * Starts loading all resources in the background. Once this is called, finishLoading() must be
+     * called repeatedly (e.g. once per frame) until it returns true.
+     */
+    void startLoading();
+
+    /**
+     * Finishes loading the resources whose images and fonts have been decoded since the last call.
+     * At most maxTextureUploads textures are uploaded per call, so that a frame never stalls for
+     * long. Must be called from the thread which owns the OpenGL context. Does not block.
+     * 
+     * @return true if all resources have been loaded, false otherwise
+     */
+    bool finishLoading(const int& maxTextureUploads);
+
+    /**
+     * Returns the fraction of the resources loaded by startLoading() which are done, in the range
+     * [0, 1].
+     */
+    float getLoadingProgress() const;
+
+    /**
+     * Returns true if the resource with the given id is currently loaded.
+     */
+    bool isLoaded(const ResourceId& id) const;
+
+    /**
+     * Evicts the least recently used textures which aren't acquired by anyone, along with their
+     * sprites, until the loaded textures fit in the texture budget. Should be called once per
+     * frame, between frames. Pointers returned by get() and getResource() may be invalid after
+     * this, while those returned by acquire() stay valid.
+     */
+    void collectGarbage();
+
+    /**
+     * Loads every resource that isn't loaded yet, then freezes the cache so that it never changes
+     * again: nothing is loaded, evicted or marked as used from then on, and collectGarbage() does
+     * nothing. Getting and acquiring resources from a frozen cache only reads it, so it's safe to
+     * do from any number of threads at once. Must be called after loading has finished, from the
+     * thread which owns the OpenGL context.
+     * @return the cache itself, through which only the const (reading) methods can be called
+     */
+    const ResourceCache& freeze();
+
+    bool isFrozen() const { return _frozen; }
+
+    /**
+     * Returns how many bytes of main memory and GPU memory all currently loaded resources take up,
+     * as reported by each resource's getCpuBytes() and getGpuBytes().
+     */
+    std::size_t getCpuBytes() const;
+    std::size_t getGpuBytes() const;
+
+    /**
+     * Prints the size and load time of each resource, and how much memory is in use.
+     */
+    void printStats(std::ostream& out) const;
+
+    /**
+     * Returns a pointer to the resource which has the specified id. The resource is loaded on the
+     * spot if it isn't loaded yet, which blocks until it's done. Template parameter T describes
+     * the type to which the resource is cast before being returned.
      * 
      * E.g. to get a SpriteResource with id "BIRD_SPRITE", you would use:
      * 
@@ -48,58 +183,271 @@ public:
      * 
      * IMPORTANT: The type specified by T must match the resource's actual type. This is checked
      * when compiling in DEBUG mode, but it is not checked in RELEASE mode.
+     * 
+     * Code that gets the same resource over and over should resolve a handle with getHandle()
+     * once and use get() instead, which skips the hash table lookup. The returned pointer is only
+     * guaranteed to be valid until the next collectGarbage(); use acquire() to hold onto it longer.
+     */
+    template <typename T>
+    const T* getResource(const ResourceId& id) {
+        return get(getHandle<T>(id));
+    }
+
+    template <typename T>
+    const T* getResource(const ResourceId& id) const {
+        return get(getHandle<T>(id));
+    }
+
+    /**
+     * Resolves a handle to the resource with the given id, making sure that the resource exists
+     * and that its type is T. Handles can be resolved as soon as loading has started, even if the
+     * resource itself hasn't been loaded yet.
      */
     template <typename T>
-    const T* getResource(const std::string& id) const {
+    ResourceHandle<T> getHandle(const ResourceId& id) const {
 
         assert(_initialized);
 
         // make sure that the resource exists
-        assert(_resources.find(id) != _resources.end());
-
-        // get resource
-        Resource* res = _resources.at(id).get();
+        auto i = _slotIndices.find(id);
+        assert(i != _slotIndices.end());
 
         // make sure that the template type matches the actual type
-        assert(res->getType() == T::TYPE);
+        assert(_slots[i->second].type == T::TYPE);
+
+        return ResourceHandle<T>(i->second);
+    }
+
+    /**
+     * Returns a pointer to the resource referred to by the given handle, loading it if need be.
+     * Like getResource(), the pointer is only guaranteed to be valid until the next
+     * collectGarbage().
+     */
+    template <typename T>
+    const T* get(const ResourceHandle<T>& handle) {
+
+        assert(handle.isValid());
+        useSlot(handle._index);
+
+        // the type was already checked when the handle was resolved
+        return static_cast<const T*>(_slots[handle._index].resource.get());
+    }
+
+    /**
+     * Same as above, for a frozen cache. Everything is loaded then, so nothing has to change.
+     */
+    template <typename T>
+    const T* get(const ResourceHandle<T>& handle) const {
+
+        assert(_frozen);
+        assert(handle.isValid());
+
+        return static_cast<const T*>(_slots[handle._index].resource.get());
+    }
+
+    /**
+     * Same as get(), but the resource stays loaded for as long as the returned pointer (or a copy
+     * of it) exists. Anything that keeps a texture or sprite around past the current frame must
+     * hold onto it this way.
+     */
+    template <typename T>
+    std::shared_ptr<const T> acquire(const ResourceHandle<T>& handle) {
+
+        assert(handle.isValid());
+        useSlot(handle._index);
+
+        return std::static_pointer_cast<const T>(_slots[handle._index].resource);
+    }
+
+    template <typename T>
+    std::shared_ptr<const T> acquire(const ResourceId& id) {
+        return acquire(getHandle<T>(id));
+    }
+
+    /**
+     * Same as above, for a frozen cache. Copying the pointer only touches its atomic reference
+     * count, so this is safe to do from any thread.
+     */
+    template <typename T>
+    std::shared_ptr<const T> acquire(const ResourceHandle<T>& handle) const {
+
+        assert(_frozen);
+        assert(handle.isValid());
 
-        return dynamic_cast<T*>(res);
+        return std::static_pointer_cast<const T>(_slots[handle._index].resource);
+    }
+
+    template <typename T>
+    std::shared_ptr<const T> acquire(const ResourceId& id) const {
+        return acquire(getHandle<T>(id));
     }
 
 private:
 
     /**
-     * Loads and stores a TextureResource with the given id from the given filename, which should be
-     * an image.
+     * A texture or font whose file is being decoded by a worker thread. Only the worker sets
+     * image/font, decodeTime and decoded, and it does so while holding the loading mutex. Textures
+     * from the archive are decoded from the start, and have their pixels point into the archive
+     * instead.
+     */
+    struct PendingFile {
+        int slot;
+        bool decoded;
+        float decodeTime;
+        sf::Image image;
+        std::shared_ptr<FontResource> font;
+        const sf::Uint8* pixels;
+        sf::Vector2u pixelsSize;
+    };
+
+    /**
+     * Where a resource is stored. Slots are made when resources are queued, and the resource is
+     * filled in once it's loaded. Slots also remember how to load their resource, so that it can be
+     * loaded lazily or again after being evicted.
+     */
+    struct Slot {
+
+        std::string id;
+        ResourceType type;
+        std::shared_ptr<Resource> resource;
+
+        // how to load textures and fonts
+        std::string filename;
+
+        // how to make sprites
+        int textureSlot;
+        std::vector<sf::IntRect> textureRects;
+        float scaleFactor;
+
+        // character sizes whose glyphs are rendered once a font is loaded
+        std::vector<unsigned int> characterSizes;
+
+        // stats
+        std::size_t cpuBytes; // as reported by the resource the last time it was loaded
+        std::size_t gpuBytes;
+        float loadTime; // seconds spent loading the last time, including decoding
+        int numLoads;
+        int lastUsedFrame;
+    };
+
+    /**
+     * Makes a slot for the resource with the given id and type, and returns its index. Asserts
+     * that no other resource has the same id, or an id with the same hash.
+     */
+    int addSlot(const std::string& id, const ResourceType& type);
+
+    /**
+     * Stores the given resource in the given slot, and records its size and load time.
+     */
+    void storeResource(const int& slot, const std::shared_ptr<Resource>& resource,
+            const float& loadTime);
+
+    /**
+     * Marks the given slot as used in this frame, and makes sure that its resource is loaded.
+     */
+    void useSlot(const int& slot);
+
+    /**
+     * Calls the load methods below for every resource in the manifest.
+     */
+    void loadAll();
+
+    /**
+     * Queues a TextureResource with the given id to be loaded from the given filename, which should
+     * be an image. The image is decoded by a worker thread.
      */
     void loadTextureResource(const std::string& id, const std::string& filename);
     
     /**
-     * Loads and stores a SpriteResource with the given id.
+     * Queues a SpriteResource with the given id to be stored once its texture is loaded.
      * @param id id
-     * @param textureResource the texture resource containing the sprite's texture
+     * @param textureId id of the texture resource containing the sprite's texture, which must
+     *                  already be queued
      * @param textureRects "frames" of the sprite's animation, must have at least 1 entry
      * @param scaleFactor amount by which the sprite is scaled as it should appear on screen
      */
-    void loadSpriteResource(const std::string& id, const TextureResource& textureResource,
+    void loadSpriteResource(const std::string& id, const std::string& textureId,
             const std::vector<sf::IntRect>& textureRects, const float& scaleFactor);
 
     /**
-     * Loads and stores a FontResource with the given id. The font is loaded from the given
-     * filename.
+     * Queues a FontResource with the given id to be loaded from the given filename. The font is
+     * loaded by a worker thread, and the glyphs of the given character sizes are rendered by the
+     * main thread once it's loaded.
+     */
+    void loadFontResource(const std::string& id, const std::string& filename,
+            const std::vector<unsigned int>& characterSizes);
+
+    /**
+     * Stores a PolygonResource with the given id. The polygon must already be a valid convex hull,
+     * which the manifest makes sure of.
+     */
+    void loadPolygonResource(const std::string& id, const b2PolygonShape& polygon);
+
+    /**
+     * Decodes a texture on a worker thread, or takes its pixels from the archive.
      */
-    void loadFontResource(const std::string& id, const std::string& filename);
+    void queueTexture(const int& slot);
 
     /**
-     * Loads and stores a PolygonResource with the given id. The polygon is created with the given
-     * vertices.
+     * Stores the decoded texture or font as a resource. For textures that were loaded up front,
+     * this also stores all of the sprites which use the texture. Must only be called once the file
+     * is decoded.
      */
-    void loadPolygonResource(const std::string& id, const std::vector<b2Vec2>& vertices);
+    void finishPendingFile(const PendingFile& pendingFile);
+
+    /**
+     * Loads the resource in the given slot on the spot. If it's being decoded, then blocks until
+     * it's done.
+     */
+    void loadNow(const int& slot);
+
+    /**
+     * Makes the sprite in the given slot, whose texture must already be loaded.
+     */
+    void makeSprite(const int& slot);
+
+    /**
+     * Returns the number of bytes of the file with the given filename.
+     */
+    static std::size_t getFileSize(const std::string& filename);
 
     bool _initialized;
 
-    // resources are stored in this maps
-    std::unordered_map<std::string, std::shared_ptr<Resource>> _resources;
+    // describes every resource that gets loaded
+    ResourceManifest _manifest;
+
+    // resources may point into the archive (e.g. fonts), so it must outlive them
+    ResourceArchive _archive;
+
+    // only set while packing
+    ResourceArchiveWriter* _archiveWriter;
+    bool _packSucceeded;
+
+    // resources are stored in slots, which are indexed by handles and by id
+    std::vector<Slot> _slots;
+    std::unordered_map<ResourceId, int, ResourceId::Hasher> _slotIndices;
+
+    // lazy loading and eviction
+    bool _lazyLoading;
+    std::size_t _textureBudget;
+    std::size_t _textureBytes; // bytes of all currently loaded textures
+    int _frame; // incremented by collectGarbage(), for telling which textures were used recently
+    int _numEvictions;
+
+    // set by freeze(), after which nothing about the cache changes
+    bool _frozen;
+
+    // files being decoded, and how many files startLoading() queued in total
+    std::vector<std::shared_ptr<PendingFile>> _pendingFiles;
+    int _numQueuedFiles;
+
+    // guards the decoded results of pending files, signaled whenever a file is decoded
+    mutable std::mutex _loadingMutex;
+    std::condition_variable _loadingCondition;
+
+    // worker threads which decode files, only exists while loading
+    std::unique_ptr<WorkerPool> _loaderPool;
+    unsigned _numLoaderThreads;
 };
 
 #endif // _RESOURCE_CACHE_HPP_
\ No newline at end of file
@@ -0,0 +1,31 @@
+#ifndef _RESOURCE_HANDLE_HPP_
+#define _RESOURCE_HANDLE_HPP_
+
+/**
+ * A pre-resolved reference to a resource of type T in the resource cache, obtained from
+ * ResourceCache::getHandle(). The type is checked once when the handle is resolved, so getting the
+ * resource through the handle is just an array index and a static_cast.
+ */
+template <typename T>
+class ResourceHandle {
+
+public:
+
+    /**
+     * Makes an invalid handle, which must be assigned a resolved handle before it's used.
+     */
+    ResourceHandle() : _index(-1) {}
+
+    bool isValid() const { return _index >= 0; }
+
+private:
+
+    friend class ResourceCache;
+
+    explicit ResourceHandle(const int& index) : _index(index) {}
+
+    // index of the resource in the resource cache
+    int _index;
+};
+
+#endif // _RESOURCE_HANDLE_HPP_
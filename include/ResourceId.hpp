@@ -0,0 +1,46 @@
+#ifndef _RESOURCE_ID_HPP_
+#define _RESOURCE_ID_HPP_
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+
+/**
+ * Identifies a resource by the 64-bit FNV-1a hash of its string id. Hashing a string literal is
+ * constexpr, so e.g. `constexpr ResourceId BIRD("BIRD_SPRITE");` costs nothing at runtime. The
+ * resource cache asserts that no two of its resources have the same hash.
+ */
+class ResourceId {
+
+public:
+
+    constexpr ResourceId(const char* id) : _hash(hash(id, _FNV_OFFSET_BASIS)) {}
+
+    ResourceId(const std::string& id) : _hash(hash(id.c_str(), _FNV_OFFSET_BASIS)) {}
+
+    constexpr std::uint64_t getHash() const { return _hash; }
+
+    constexpr bool operator==(const ResourceId& other) const { return _hash == other._hash; }
+    constexpr bool operator!=(const ResourceId& other) const { return _hash != other._hash; }
+
+    /**
+     * So that ResourceIds can be used as keys of unordered maps.
+     */
+    struct Hasher {
+        std::size_t operator()(const ResourceId& id) const { return (std::size_t)id._hash; }
+    };
+
+private:
+
+    // written recursively so that it can be constexpr in C++11
+    static constexpr std::uint64_t hash(const char* id, std::uint64_t h) {
+        return *id == '\0' ? h : hash(id + 1, (h ^ (unsigned char)*id) * _FNV_PRIME);
+    }
+
+    static constexpr std::uint64_t _FNV_OFFSET_BASIS = 14695981039346656037ull;
+    static constexpr std::uint64_t _FNV_PRIME = 1099511628211ull;
+
+    std::uint64_t _hash;
+};
+
+#endif // _RESOURCE_ID_HPP_
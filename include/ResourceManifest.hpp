@@ -0,0 +1,100 @@
+#ifndef _RESOURCE_MANIFEST_HPP_
+#define _RESOURCE_MANIFEST_HPP_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <SFML/Graphics.hpp>
+#include <box2d/box2d.h>
+
+/**
+ * Describes every resource the game uses: which files textures and fonts are loaded from, the
+ * frames and scale of each sprite, and the hitbox polygons. The resource cache loads whatever the
+ * manifest describes, so the set of resources can be changed without recompiling.
+ * 
+ * A manifest is written as text (see data/resources.manifest for the format), and can be compiled
+ * into a binary manifest with the compile_manifest tool. Compiling does all the validation, traces
+ * the polygons which are traced from sprites, and stores each polygon's convex hull, normals and
+ * centroid, so loading a binary manifest is a single pass over the file that doesn't compute
+ * anything.
+ */
+class ResourceManifest {
+
+public:
+
+    struct Texture {
+        std::string id;
+        std::string filename;
+    };
+
+    struct Sprite {
+        std::string id;
+        std::string textureId;
+        float scaleFactor;
+        std::vector<sf::IntRect> frames;
+    };
+
+    struct Font {
+        std::string id;
+        std::string filename;
+        std::vector<unsigned int> characterSizes; // sizes whose glyphs are rendered while loading
+    };
+
+    struct Polygon {
+        std::string id;
+        b2PolygonShape shape;
+    };
+
+    ResourceManifest();
+
+    /**
+     * Loads a binary manifest, or a text manifest if the file isn't a binary one. Problems with
+     * the file are printed to std::cerr.
+     * @return true if the manifest was loaded, false otherwise
+     */
+    bool load(const std::string& filename);
+
+    /**
+     * Writes the manifest in its binary form.
+     * @return true if the file was written, false otherwise
+     */
+    bool save(const std::string& filename) const;
+
+    bool isLoaded() const { return _loaded; }
+
+    /**
+     * Returns a hash of what a resource archive packs from this manifest, i.e. the id and file of
+     * every texture and font. An archive only matches the manifest that it was packed from, since
+     * it finds resources by id.
+     */
+    std::uint64_t getArchiveHash() const;
+
+    // everything that the manifest describes; textures always come before the sprites using them
+    std::vector<Texture> textures;
+    std::vector<Sprite> sprites;
+    std::vector<Font> fonts;
+    std::vector<Polygon> polygons;
+
+    static const char MAGIC[4];
+    static const std::uint32_t VERSION = 2;
+
+private:
+
+    /**
+     * Parses the text form of the manifest from the given contents, checking that ids are unique,
+     * that sprites refer to existing textures, and that polygons are convex.
+     */
+    bool parseText(const std::string& contents, const std::string& filename);
+
+    /**
+     * Reads the binary form of the manifest from the given contents.
+     */
+    bool parseBinary(const std::string& contents, const std::string& filename);
+
+    void clear();
+
+    bool _loaded;
+};
+
+#endif // _RESOURCE_MANIFEST_HPP_
@@ -1,26 +1,73 @@
 #ifndef _FONT_RESOURCE_HPP_
 #define _FONT_RESOURCE_HPP_
 
+#include <string>
+#include <vector>
+
 #include <SFML/Graphics.hpp>
 
 #include "Resource.hpp"
 
 /**
- * Stores an SFML Sprite along with a vector of texture rectangles denoting the different "frames"
- * that the sprite can have. If the sprite is not animated, then the length of this vector is 1. If
- * the sprite is animated, then the length is > 1.
+ * Stores an SFML Font, which is opened straight from the given file or memory.
  */
 class FontResource : public Resource {
 
 public:
 
-    FontResource(const sf::Font& ft) : font(ft) {}
+    /**
+     * Opens the font file with the given filename, which is fileSize bytes long.
+     */
+    FontResource(const std::string& filename, const std::size_t& fileSize) :
+        _fileSize(fileSize)
+    {
+        font.loadFromFile(filename);
+    }
+
+    /**
+     * Opens the font from the given memory, which must stay valid for as long as the font is used.
+     */
+    FontResource(const void* data, const std::size_t& size) :
+        _fileSize(size)
+    {
+        font.loadFromMemory(data, size);
+    }
+
+    /**
+     * Renders the glyphs of all printable ASCII characters at each of the given character sizes, so
+     * that drawing text in those sizes never has to render glyphs on the spot. Must be called from
+     * the thread which owns the OpenGL context, since the glyphs are uploaded into textures.
+     */
+    void renderGlyphs(const std::vector<unsigned int>& characterSizes) {
+        for (unsigned int characterSize : characterSizes) {
+            for (sf::Uint32 character = ' '; character <= '~'; ++character)
+                font.getGlyph(character, characterSize, false);
+        }
+        _characterSizes = characterSizes;
+    }
 
     const ResourceType& getType() const override { return TYPE; }
 
+    std::size_t getCpuBytes() const override { return sizeof(FontResource) + _fileSize; }
+
+    // only counts the glyph textures of the sizes rendered up front
+    std::size_t getGpuBytes() const override {
+        std::size_t bytes = 0;
+        for (unsigned int characterSize : _characterSizes) {
+            sf::Vector2u size = font.getTexture(characterSize).getSize();
+            bytes += (std::size_t)size.x * size.y * 4;
+        }
+        return bytes;
+    }
+
     static const ResourceType TYPE;
     
-    const sf::Font font;
+    sf::Font font;
+
+private:
+
+    std::size_t _fileSize;
+    std::vector<unsigned int> _characterSizes;
 };
 
 #endif // _FONT_RESOURCE_HPP
@@ -17,6 +17,8 @@ public:
 
     const ResourceType& getType() const override { return TYPE; }
 
+    std::size_t getCpuBytes() const override { return sizeof(PolygonResource); }
+
     static const ResourceType TYPE;
     
     const b2PolygonShape polygon;
@@ -7,33 +7,48 @@
 #include <SFML/Graphics.hpp>
 
 #include "Resource.hpp"
+#include "Resources/TextureResource.hpp"
 
 /**
  * Stores an SFML Sprite along with a vector of texture rectangles denoting the different "frames"
  * that the sprite can have. If the sprite is not animated, then the length of this vector is 1. If
  * the sprite is animated, then the length is > 1. Also stores the sacle factor of the sprite.
+ * 
+ * The sprite holds onto its texture resource, so the texture stays loaded for as long as the
+ * sprite does.
  */
 class SpriteResource : public Resource {
 
 public:
 
+    /**
+     * Makes the sprite from the given texture, with its texture rectangle set to the first frame.
+     * textureRects must have at least 1 entry.
+     */
     SpriteResource(
-        const sf::Sprite& sprite, 
+        const std::shared_ptr<const TextureResource>& texture,
         const std::vector<sf::IntRect>& textureRects,
         const float& scaleFactor
     ) :
-        sprite(sprite),
+        sprite(texture->texture, textureRects.at(0)),
         textureRects(textureRects),
-        scaleFactor(scaleFactor)
+        scaleFactor(scaleFactor),
+        texture(texture)
     {}
 
     const ResourceType& getType() const override { return TYPE; }
 
+    // the texture belongs to its own resource, so only the frames are counted
+    std::size_t getCpuBytes() const override {
+        return sizeof(SpriteResource) + textureRects.size() * sizeof(sf::IntRect);
+    }
+
     static const ResourceType TYPE;
     
     const sf::Sprite sprite;
     const std::vector<sf::IntRect> textureRects;
     const float scaleFactor; // how many pixels wide the sprite should appear on screen
+    const std::shared_ptr<const TextureResource> texture;
 };
 
 #endif // _SPRITE_RESOURCE_HPP
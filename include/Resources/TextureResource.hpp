@@ -8,19 +8,35 @@
 #include "Resource.hpp"
 
 /**
- * Stores an SFML Texture.
+ * Stores an SFML Texture. The texture is uploaded straight from the given image or pixels.
  */
 class TextureResource : public Resource {
 
 public:
 
-    TextureResource (const sf::Texture& texture) : texture(texture) {}
+    TextureResource(const sf::Image& image) {
+        texture.loadFromImage(image);
+    }
+
+    /**
+     * Uploads the given RGBA pixels, which must be size.x * size.y * 4 bytes.
+     */
+    TextureResource(const sf::Uint8* pixels, const sf::Vector2u& size) {
+        texture.create(size.x, size.y);
+        texture.update(pixels);
+    }
 
     const ResourceType& getType() const override { return TYPE; }
 
+    std::size_t getCpuBytes() const override { return sizeof(TextureResource); }
+
+    std::size_t getGpuBytes() const override {
+        return (std::size_t)texture.getSize().x * texture.getSize().y * 4;
+    }
+
     static const ResourceType TYPE;
     
-    const sf::Texture texture;
+    sf::Texture texture;
 };
 
 #endif // _TEXTURE_RESOURCE_HPP_
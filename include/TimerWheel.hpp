@@ -0,0 +1,123 @@
+#ifndef _TIMER_WHEEL_HPP_
+#define _TIMER_WHEEL_HPP_
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+/**
+ * Calls functions once given delays have passed, as time is advanced with advance(). Used for
+ * anything that should happen after a while, e.g. an NPC finishing its action or an animation
+ * moving on to its next frame, so that waiting costs nothing; only timers which expire do any work.
+ *
+ * Timers are kept in a hierarchical timing wheel: time is split into ticks, and the first level
+ * has one slot for each of the next 256 ticks. Each of the three levels above covers 64 times as
+ * much time as the one below with 64 slots, and its timers are moved down a level whenever the
+ * level below wraps around. Scheduling and cancelling take constant time, and the timers are
+ * pooled, so neither allocates once the pool has grown to the number of pending timers.
+ *
+ * Not thread safe; the timers' functions are called by whichever thread calls advance().
+ */
+class TimerWheel {
+
+public:
+
+    // identifies a scheduled timer, stays unique after the timer expires or is cancelled
+    typedef std::uint64_t Handle;
+    static const Handle NO_TIMER = 0;
+
+    /**
+     * Makes a wheel whose time starts at 0, and whose timers expire at the first tick at or after
+     * their expiry time.
+     */
+    TimerWheel(const float& tickDuration = 0.001f);
+
+    /**
+     * Schedules the given function to be called once the given number of seconds have passed, by
+     * the advance() which passes that point. A timer scheduled while timers are being called is
+     * never called before the next tick.
+     * @return handle through which the timer can be cancelled
+     */
+    Handle schedule(const float& delay, const std::function<void()>& function);
+
+    /**
+     * Cancels the given timer if it's still pending, and sets the handle to NO_TIMER. Does nothing
+     * for a handle of a timer which already expired or was cancelled.
+     */
+    void cancel(Handle& handle);
+
+    /**
+     * Returns true if the given timer has neither expired nor been cancelled yet.
+     */
+    bool isPending(const Handle& handle) const;
+
+    /**
+     * Cancels every pending timer.
+     */
+    void clear();
+
+    /**
+     * Moves time forward by the given number of seconds, calling the functions of the timers which
+     * expire, in the order that they expire.
+     */
+    void advance(const float& timeDelta);
+
+    /**
+     * Returns the number of seconds that the wheel has been advanced by in total. While a timer's
+     * function is being called, returns the time at which the timer expired instead, so that a
+     * timer which schedules itself again keeps a steady period.
+     */
+    double getTime() const { return _time; }
+
+private:
+
+    // no copying, the functions may refer to the wheel's timers
+    TimerWheel(const TimerWheel&);
+    TimerWheel& operator=(const TimerWheel&);
+
+    struct Timer {
+        std::function<void()> function;
+        std::uint64_t expiryTick;
+        std::uint32_t generation; // incremented every time the timer is freed
+        int previous;             // neighbors in the slot's list, or in the free list
+        int next;
+        int slot;                 // index into _slots, or -1 if the timer isn't pending
+    };
+
+    /**
+     * Puts the given pending timer into the slot which its expiry tick belongs in.
+     */
+    void insert(const int& index);
+
+    /**
+     * Removes the given timer from its slot's list.
+     */
+    void unlink(const int& index);
+
+    /**
+     * Returns the timer to the pool.
+     */
+    void free(const int& index);
+
+    /**
+     * Moves every timer in the given slot of the given level (1 to 3) down to lower levels.
+     * @return the index of the slot
+     */
+    int cascade(const int& level, const int& slot);
+
+    const double _TICK_DURATION;
+    double _time;
+    std::uint64_t _currentTick; // the last tick whose timers were called
+
+    // 256 slots for the first level, then 64 slots for each of the others; each slot holds the
+    // index of the first timer in its list, or -1
+    static const int _NUM_FIRST_SLOTS = 256;
+    static const int _NUM_SLOTS = 64;
+    static const int _NUM_LEVELS = 4;
+    std::vector<int> _slots;
+
+    std::vector<Timer> _timers;
+    int _firstFree;
+};
+
+#endif // _TIMER_WHEEL_HPP_
@@ -0,0 +1,75 @@
+#ifndef _TRIPLE_BUFFER_HPP_
+#define _TRIPLE_BUFFER_HPP_
+
+#include <atomic>
+
+/**
+ * Three values of type T passed from one writer thread to one reader thread without either one
+ * waiting on the other. The writer fills its write buffer and publishes it, which swaps it with
+ * the middle buffer. The reader acquires the middle buffer if something was published since its
+ * last acquire, and reads it until the next acquire. If the writer publishes faster than the reader
+ * acquires, the buffers in between are skipped, so the reader always gets the latest one.
+ *
+ * Only the middle buffer is shared, and its index is swapped atomically along with a bit telling
+ * whether it's newer than the read buffer.
+ */
+template <typename T>
+class TripleBuffer {
+
+public:
+
+    TripleBuffer() : _writeIndex(0), _middle(1), _readIndex(2) {}
+
+    /**
+     * The buffer that the writer fills next. Its previous contents are whatever was published three
+     * buffers ago, or older.
+     */
+    T& getWriteBuffer() { return _buffers[_writeIndex]; }
+
+    /**
+     * Makes the write buffer available to the reader and gets a new write buffer. Called by the
+     * writer.
+     */
+    void publish() {
+        _writeIndex = _middle.exchange(_writeIndex | _NEW_BIT, std::memory_order_acq_rel) &
+                _INDEX_MASK;
+    }
+
+    /**
+     * Makes the latest published buffer the read buffer. Returns false and keeps the current read
+     * buffer if nothing was published since the last call. Called by the reader.
+     */
+    bool acquire() {
+        if (!(_middle.load(std::memory_order_acquire) & _NEW_BIT))
+            return false;
+        _readIndex = _middle.exchange(_readIndex, std::memory_order_acq_rel) & _INDEX_MASK;
+        return true;
+    }
+
+    /**
+     * Returns true if something was published since the last acquire. Called by the reader.
+     */
+    bool hasPublished() const { return _middle.load(std::memory_order_acquire) & _NEW_BIT; }
+
+    /**
+     * The buffer that the reader acquired last.
+     */
+    const T& getReadBuffer() const { return _buffers[_readIndex]; }
+
+private:
+
+    // no copying
+    TripleBuffer(const TripleBuffer&);
+    TripleBuffer& operator=(const TripleBuffer&);
+
+    static const int _INDEX_MASK = 0x3;
+    static const int _NEW_BIT = 0x4;
+
+    T _buffers[3];
+
+    int _writeIndex; // only used by the writer
+    std::atomic<int> _middle; // index of the middle buffer, plus _NEW_BIT if it was just published
+    int _readIndex; // only used by the reader
+};
+
+#endif // _TRIPLE_BUFFER_HPP_
@@ -2,6 +2,9 @@
 #define _UTILS_HPP_
 
 #include <random>
+#include <thread>
+#include <functional>
+#include <vector>
 
 #include <SFML/Graphics.hpp>
 #include <box2d/box2d.h>
@@ -11,9 +14,11 @@
 // Note: Simple math functions and conversion functions get the inline. Other functions do not.
 
 // Variables for random number functions, they are in an anonymous namespace so that they stay local
-// to this file.
+// to this file. Each thread gets its own engine, so that jobs can use the random number functions
+// at the same time; the thread's id is mixed into the seed so that the engines differ.
 namespace {
-    std::default_random_engine rng(time(NULL));
+    thread_local std::default_random_engine rng(
+            time(NULL) ^ std::hash<std::thread::id>()(std::this_thread::get_id()));
 }
 
 /**
@@ -116,6 +121,16 @@ void scalePolygon(b2PolygonShape& polygon, const b2Vec2& scale);
  */
 void fitPolygonToSprite(b2PolygonShape& polygon, const sf::Sprite& sprite);
 
+/**
+ * Returns the convex hull of the pixels inside the given rectangle of the given image whose alpha
+ * is at least alphaThreshold, in normalized coordinates (see fitPolygonToSprite()) and in
+ * counter-clockwise order. The hull is simplified to at most maxVertices vertices (which must be at
+ * least 3) by repeatedly removing the vertex that takes the least area with it; vertices too close
+ * together for box2d are removed the same way. Returns no vertices if no pixel is opaque enough.
+ */
+std::vector<b2Vec2> traceConvexHull(const sf::Image& image, const sf::IntRect& rect,
+        const int& maxVertices, const sf::Uint8& alphaThreshold = 128);
+
 /**
  * Centers the given text on the given point.
  */
@@ -0,0 +1,66 @@
+#ifndef _WORKER_POOL_HPP_
+#define _WORKER_POOL_HPP_
+
+#include <functional>
+#include <vector>
+#include <queue>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+/**
+ * A fixed number of worker threads which run tasks in the order in which they were pushed. Used
+ * for work that shouldn't happen on the main thread, e.g. decoding images.
+ * 
+ * Tasks which are still queued when the pool is destroyed are never run; the destructor only waits
+ * for the tasks which are currently running.
+ */
+class WorkerPool {
+
+public:
+
+    /**
+     * Starts the given number of worker threads. If numThreads is 0, then one thread is started
+     * for every hardware thread except the one that the main thread uses (but at least one).
+     */
+    WorkerPool(unsigned numThreads = 0);
+
+    /**
+     * Stops and joins all worker threads.
+     */
+    ~WorkerPool();
+
+    /**
+     * Queues the given task to be run by one of the worker threads.
+     */
+    void push(const std::function<void()>& task);
+
+    /**
+     * Blocks until all tasks pushed so far have finished running.
+     */
+    void wait();
+
+    unsigned getNumThreads() const { return _threads.size(); }
+
+private:
+
+    // copying a pool doesn't make sense
+    WorkerPool(const WorkerPool&);
+    WorkerPool& operator=(const WorkerPool&);
+
+    /**
+     * Loop run by every worker thread.
+     */
+    void workerLoop();
+
+    std::vector<std::thread> _threads;
+    std::queue<std::function<void()>> _tasks;
+    unsigned _numRunning;
+    bool _stopping;
+
+    std::mutex _mutex;
+    std::condition_variable _taskCondition; // signaled when a task is pushed or when stopping
+    std::condition_variable _idleCondition; // signaled when a task finishes
+};
+
+#endif // _WORKER_POOL_HPP_
@@ -109,7 +109,7 @@ void Button::toClicked() {
     setOpacity(_opacity);
 }
 
-void Button::draw(sf::RenderTarget& target, sf::RenderStates states) const {
-    target.draw(_shape);
-    target.draw(_text);
+void Button::draw(RenderSnapshot& snapshot, const sf::RenderStates& states) const {
+    snapshot.add(_shape, states);
+    snapshot.add(_text, states);
 }
@@ -0,0 +1,144 @@
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <iostream>
+
+#include "CourseFile.hpp"
+#include "Globals.hpp"
+
+const char CourseFile::MAGIC[4] = {'G', 'B', 'C', 'O'};
+
+namespace {
+
+    // Bounds of the values in a record, well beyond what the course generator makes, but small
+    // enough that nothing absurd gets spawned from a corrupt course.
+    const float MAX_DISTANCE = 50.0f;
+    const float MAX_HEIGHT = 20.0f;
+    const int MAX_DOCKS_SIZE = 10;
+
+    bool isInRange(const float& value, const float& low, const float& high) {
+        return std::isfinite(value) && value >= low && value <= high;
+    }
+
+    bool isWholeInRange(const float& value, const int& low, const int& high) {
+        return isInRange(value, low, high) && value == std::floor(value);
+    }
+
+    // whether the given record can be spawned
+    bool isValid(const CourseRecord& record) {
+
+        if (record.kind > CourseRecord::LONE_NPC || record.npc > CourseRecord::FEMALE ||
+                (record.kind == CourseRecord::LONE_NPC && record.npc == CourseRecord::NO_NPC))
+            return false;
+        if (!isInRange(record.offset, -MAX_DISTANCE, MAX_DISTANCE) || record.length <= 0.0f ||
+                !isInRange(record.length, 0.0f, MAX_DISTANCE))
+            return false;
+        for (const float& value : record.values) {
+            if (!std::isfinite(value))
+                return false;
+        }
+
+        switch (record.kind) {
+        case CourseRecord::STREETLIGHT:
+        case CourseRecord::TREE:
+            return record.values[0] > 0.0f && record.values[0] <= MAX_HEIGHT;
+        case CourseRecord::CLOUD:
+            return isInRange(record.values[0], 0.0f, MAX_HEIGHT);
+        case CourseRecord::DOCKS:
+            return isWholeInRange(record.values[0], 1, MAX_DOCKS_SIZE) &&
+                    isWholeInRange(record.values[1], 1, MAX_DOCKS_SIZE) &&
+                    isInRange(record.values[2], -MAX_DISTANCE, MAX_DISTANCE);
+        case CourseRecord::UMBRELLA:
+            return isInRange(record.values[0], -PI / 2.0f, PI / 2.0f);
+        default:
+            return true;
+        }
+    }
+}
+
+const char* CourseRecord::getKindName(const uint8_t& kind) {
+    switch (kind) {
+    case STREETLIGHT: return "STREETLIGHT";
+    case TREE:        return "TREE";
+    case CLOUD:       return "CLOUD";
+    case LIFEGUARD:   return "LIFEGUARD";
+    case DOCKS:       return "DOCKS";
+    case UMBRELLA:    return "UMBRELLA";
+    case LONE_NPC:    return "LONE_NPC";
+    default:          return "undefined";
+    }
+}
+
+bool CourseFile::open(const std::string& filename) {
+
+    close();
+
+    if (!_file.open(filename))
+        return false;
+
+    const unsigned char* data = _file.getData();
+    std::size_t size = _file.getSize();
+
+    // check the header, a course needs at least one record
+    std::uint32_t version = 0;
+    std::uint32_t numRecords = 0;
+    std::uint32_t seed = 0;
+    if (size >= HEADER_SIZE) {
+        std::memcpy(&version, data + 4, sizeof(version));
+        std::memcpy(&numRecords, data + 8, sizeof(numRecords));
+        std::memcpy(&seed, data + 12, sizeof(seed));
+    }
+    if (size < HEADER_SIZE || std::memcmp(data, MAGIC, sizeof(MAGIC)) != 0 || version != VERSION ||
+            numRecords == 0 ||
+            size < HEADER_SIZE + (std::uint64_t)numRecords * sizeof(CourseRecord)) {
+        std::cerr << "not a valid course: " << filename << std::endl;
+        close();
+        return false;
+    }
+    _numRecords = numRecords;
+
+    // make sure that every record can be spawned
+    for (std::size_t i = 0; i < _numRecords; ++i) {
+        if (!isValid(getRecord(i))) {
+            std::cerr << "corrupt record " << i << " in course: " << filename << std::endl;
+            close();
+            return false;
+        }
+    }
+
+    _seed = seed;
+    return true;
+}
+
+void CourseFile::close() {
+    _file.close();
+    _numRecords = 0;
+    _seed = 0;
+}
+
+const CourseRecord& CourseFile::getRecord(const std::size_t& index) const {
+
+    assert(isOpen());
+    assert(index < _numRecords);
+
+    return ((const CourseRecord*)(_file.getData() + HEADER_SIZE))[index];
+}
+
+bool CourseFile::write(const std::string& filename, const std::uint32_t& seed,
+        const std::vector<CourseRecord>& records) {
+
+    std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+    if (!file)
+        return false;
+
+    std::uint32_t header[4] = {0, VERSION, (std::uint32_t)records.size(), seed};
+    std::memcpy(header, MAGIC, sizeof(MAGIC));
+    file.write((const char*)header, sizeof(header));
+    file.write((const char*)records.data(), records.size() * sizeof(CourseRecord));
+
+    return (bool)file;
+}
@@ -0,0 +1,125 @@
+#include <cstdint>
+#include <random>
+
+#include "CourseGenerator.hpp"
+#include "CourseFile.hpp"
+#include "Globals.hpp"
+
+CourseGenerator::CourseGenerator(const std::uint32_t& seed) :
+    _MAX_DISTANCE_BETWEEN_NPCS(NATIVE_RESOLUTION.x * METERS_PER_PIXEL)
+{
+    this->seed(seed);
+}
+
+void CourseGenerator::seed(const std::uint32_t& seed) {
+    _engine.seed(seed);
+    _lastKind = -1;
+    _distanceSinceNPC = 0.0f;
+}
+
+CourseRecord CourseGenerator::next(const bool& forceNPC, const float& demoBirdHeight) {
+
+    CourseRecord record = {};
+    bool forDemo = demoBirdHeight >= 0.0f;
+
+    // Keep rolling until something is generated: a streetlight can't come directly after a tree.
+    // Each of the kinds has the same chance, but the same non-NPC kind never comes twice in a row.
+    while (true) {
+
+        int kind = rollInt(CourseRecord::STREETLIGHT, CourseRecord::LONE_NPC);
+        while (kind == _lastKind)
+            kind = rollInt(CourseRecord::STREETLIGHT, CourseRecord::LONE_NPC);
+
+        if (forceNPC || _distanceSinceNPC >= _MAX_DISTANCE_BETWEEN_NPCS)
+            kind = CourseRecord::LONE_NPC;
+
+        if (kind == CourseRecord::STREETLIGHT && _lastKind == CourseRecord::TREE)
+            continue;
+
+        record.kind = kind;
+        break;
+    }
+
+    float heightMeters = rollFloat(4.0f, (forDemo ? 9.0f : 10.0f));
+    bool faceLeft = rollBool();
+
+    // where the entity is placed, and where its right edge is
+    float rightEdge = 0.0f;
+    switch (record.kind) {
+        case CourseRecord::STREETLIGHT:
+            record.faceLeft = faceLeft;
+            record.values[0] = heightMeters;
+            record.offset = faceLeft ? 2.7f : 1.0f;
+            rightEdge = record.offset + (faceLeft ? 1.0f : 2.7f);
+            break;
+        case CourseRecord::TREE:
+            record.faceLeft = faceLeft;
+            record.values[0] = heightMeters;
+            record.offset = faceLeft ? 1.44f + heightMeters * 0.65f : 2.5f;
+            rightEdge = record.offset + (faceLeft ? 2.5f : 1.44f + heightMeters * 0.65f);
+            break;
+        case CourseRecord::CLOUD:
+            record.values[0] = rollFloat(6.0f, 12.0f);
+            if (forDemo)
+                record.values[0] = rollBool() ? rollFloat(6.0f, demoBirdHeight - 1.1f) :
+                        rollFloat(demoBirdHeight + 1.1f, 12.0f);
+            record.offset = 1.0f;
+            rightEdge = 2.0f;
+            break;
+        case CourseRecord::LIFEGUARD:
+            record.faceLeft = faceLeft;
+            record.offset = 2.3f;
+            rightEdge = 4.6f;
+            break;
+        case CourseRecord::DOCKS:
+            {
+                int width = rollInt(2, 5);
+                record.values[0] = width;
+                record.values[1] = rollInt(1, 5);
+                record.offset = -0.8f;
+                rightEdge = record.offset + 1.0f + width * 1.9f;
+                if (rollBool()) {
+                    record.npc = rollBool() ? CourseRecord::MALE : CourseRecord::FEMALE;
+                    record.values[2] = record.offset + rollFloat(2.0f, 2.0f + width);
+                }
+                break;
+            }
+        case CourseRecord::UMBRELLA:
+            record.values[0] = rollFloat(-PI / 4.0f, PI / 4.0f);
+            record.offset = 1.5f;
+            rightEdge = 3.0f;
+            break;
+        case CourseRecord::LONE_NPC:
+            record.npc = rollBool() ? CourseRecord::MALE : CourseRecord::FEMALE;
+            record.offset = rollFloat(1.0f, 3.0f); // give the NPC some room to move around
+            rightEdge = record.offset + 1.0f;
+            break;
+    }
+
+    // give the next stretch some breathing room
+    record.length = rightEdge + rollFloat(0.0f, 4.0f);
+
+    // remember what was generated, but don't worry about the kind if it was an NPC
+    if (record.kind != CourseRecord::LONE_NPC)
+        _lastKind = record.kind;
+    if (record.npc != CourseRecord::NO_NPC)
+        _distanceSinceNPC = 0.0f;
+    else
+        _distanceSinceNPC += record.length;
+
+    return record;
+}
+
+int CourseGenerator::rollInt(const int& low, const int& high) {
+    std::uniform_int_distribution<int> dist(low, high);
+    return dist(_engine);
+}
+
+float CourseGenerator::rollFloat(const float& low, const float& high) {
+    std::uniform_real_distribution<float> dist(low, high);
+    return dist(_engine);
+}
+
+bool CourseGenerator::rollBool() {
+    return rollInt(0, 1) == 0;
+}
@@ -9,21 +9,22 @@
 
 DebugDrawer::DebugDrawer() :
     _initialized(false),
-    _renderTarget(nullptr),
+    _snapshot(nullptr),
     _OUTLINE_THICKNESS(1.0f)
 {}
 
-void DebugDrawer::init(sf::RenderTarget& target) {
-
-    _renderTarget = &target;
-
+void DebugDrawer::init() {
     _initialized = true;
 }
 
+void DebugDrawer::setSnapshot(RenderSnapshot& snapshot) {
+    _snapshot = &snapshot;
+}
+
 void DebugDrawer::DrawPolygon(const b2Vec2* vertices, int32 vertexCount, const b2Color& color) {
 
     assert(_initialized);
-    assert(_renderTarget);
+    assert(_snapshot);
 
     sf::ConvexShape polygon(vertexCount);
     for (int i = 0; i < vertexCount; ++i)
@@ -33,14 +34,14 @@ void DebugDrawer::DrawPolygon(const b2Vec2* vertices, int32 vertexCount, const b
     polygon.setOutlineColor(sf::Color::Red);
     polygon.setOutlineThickness(_OUTLINE_THICKNESS);
 
-    _renderTarget->draw(polygon);
+    _snapshot->add(polygon);
 }
 
 void DebugDrawer::DrawSolidPolygon(const b2Vec2* vertices, int32 vertexCount,
         const b2Color& color) {
 
     assert(_initialized);
-    assert(_renderTarget);
+    assert(_snapshot);
     
     DrawPolygon(vertices, vertexCount, color);
 }
@@ -48,7 +49,7 @@ void DebugDrawer::DrawSolidPolygon(const b2Vec2* vertices, int32 vertexCount,
 void DebugDrawer::DrawCircle(const b2Vec2& center, float radius, const b2Color& color) {
 
     assert(_initialized);
-    assert(_renderTarget);
+    assert(_snapshot);
 
     float radiusPixels = radius * PIXELS_PER_METER;
 
@@ -60,14 +61,14 @@ void DebugDrawer::DrawCircle(const b2Vec2& center, float radius, const b2Color&
     circle.setOutlineColor(sf::Color::Red);
     circle.setOutlineThickness(_OUTLINE_THICKNESS);
 
-    _renderTarget->draw(circle);
+    _snapshot->add(circle);
 }
 
 void DebugDrawer::DrawSolidCircle(const b2Vec2& center, float radius, const b2Vec2& axis,
         const b2Color& color) {
 
     assert(_initialized);
-    assert(_renderTarget);
+    assert(_snapshot);
 
     DrawCircle(center, radius, color);
     DrawSegment(center, center + radius * axis, color);
@@ -76,7 +77,7 @@ void DebugDrawer::DrawSolidCircle(const b2Vec2& center, float radius, const b2Ve
 void DebugDrawer::DrawSegment(const b2Vec2& p1, const b2Vec2& p2, const b2Color& color) {
 
     assert(_initialized);
-    assert(_renderTarget);
+    assert(_snapshot);
 
     sf::ConvexShape line(4);
     line.setPoint(0, physicalToGraphicalCoord(p1));
@@ -88,13 +89,13 @@ void DebugDrawer::DrawSegment(const b2Vec2& p1, const b2Vec2& p2, const b2Color&
     line.setOutlineColor(sf::Color::Blue);
     line.setOutlineThickness(_OUTLINE_THICKNESS);
 
-    _renderTarget->draw(line);
+    _snapshot->add(line);
 }
 
 void DebugDrawer::DrawTransform(const b2Transform& xf) {
 
     assert(_initialized);
-    assert(_renderTarget);
+    assert(_snapshot);
 
     DrawPoint(xf.p, _OUTLINE_THICKNESS * 2.0f, b2Color(1.0f, 0.0f, 0.0f, 1.0f));
 
@@ -106,12 +107,12 @@ void DebugDrawer::DrawTransform(const b2Transform& xf) {
 void DebugDrawer::DrawPoint(const b2Vec2& p, float size, const b2Color& color) {
 
     assert(_initialized);
-    assert(_renderTarget);
+    assert(_snapshot);
 
     sf::CircleShape point(size);
     point.setPosition(physicalToGraphicalCoord(p));
 
     point.setFillColor(sf::Color::Blue);
 
-    _renderTarget->draw(point);
+    _snapshot->add(point);
 }
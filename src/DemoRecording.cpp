@@ -0,0 +1,89 @@
+#include <cassert>
+#include <cmath>
+#include <algorithm>
+#include <limits>
+
+#include <SFML/Graphics.hpp>
+#include <box2d/box2d.h>
+
+#include "DemoRecording.hpp"
+#include "GameLogic.hpp"
+#include "Globals.hpp"
+
+DemoRecording::DemoRecording() :
+    _length(0.0f)
+{}
+
+void DemoRecording::clear() {
+
+    _looks.clear();
+    _placements.clear();
+    _frames.clear();
+    _length = 0.0f;
+    _lastLooks.clear();
+}
+
+void DemoRecording::recordFrame(const GameLogic& logic, const float& timeDelta) {
+
+    // the first frame is shown from the start of the recording
+    if (!_frames.empty())
+        _length += timeDelta;
+    _frames.push_back({_length, _placements.size()});
+
+    // place every visible actor the same way as HumanView draws them
+    for (PhysicalActor* actor : logic.getVisibleActors()) {
+
+        const b2Body* body = logic.getBody(actor);
+        assert(body);
+
+        Placement placement;
+        placement.look = findLook(actor);
+        placement.x = body->GetPosition().x * PIXELS_PER_METER;
+        placement.y = NATIVE_RESOLUTION.y - body->GetPosition().y * PIXELS_PER_METER;
+        placement.rotation = -180.0f / PI * body->GetAngle();
+        _placements.push_back(placement);
+    }
+}
+
+void DemoRecording::draw(RenderSnapshot& snapshot, const float& time) const {
+
+    if (_frames.empty())
+        return;
+
+    // find the last frame which starts at or before the given time
+    float wrappedTime = _length > 0.0f ? std::fmod(time, _length) : 0.0f;
+    auto frame = std::upper_bound(_frames.begin(), _frames.end(), wrappedTime,
+            [](const float& time, const Frame& frame) { return time < frame.time; });
+    if (frame != _frames.begin())
+        --frame;
+
+    std::size_t end = frame + 1 == _frames.end() ? _placements.size() : (frame + 1)->firstPlacement;
+    for (std::size_t i = frame->firstPlacement; i < end; ++i) {
+        const Placement& placement = _placements[i];
+        sf::RenderStates states;
+        states.transform.translate(placement.x, placement.y).rotate(placement.rotation);
+        snapshot.add(_looks[placement.look], states);
+    }
+}
+
+int DemoRecording::findLook(const PhysicalActor* actor) {
+
+    _look.clear();
+    actor->draw(_look);
+
+    // try the look that the actor had last time first, then all of them
+    auto lastLook = _lastLooks.find(actor);
+    if (lastLook != _lastLooks.end() && _looks[lastLook->second].isSameAs(_look))
+        return lastLook->second;
+
+    int look = 0;
+    while (look < (int)_looks.size() && !_looks[look].isSameAs(_look))
+        ++look;
+    if (look == (int)_looks.size()) {
+        assert(_looks.size() < std::numeric_limits<std::uint16_t>::max());
+        _looks.push_back(_look);
+    }
+
+    _lastLooks[actor] = look;
+    return look;
+}
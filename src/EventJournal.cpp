@@ -0,0 +1,225 @@
+#include <cassert>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#include "EventJournal.hpp"
+#include "Event.hpp"
+#include "Events/CollisionEvent.hpp"
+#include "Events/KeyPressEvent.hpp"
+#include "Events/KeyReleaseEvent.hpp"
+#include "Events/MouseMoveEvent.hpp"
+#include "Events/MousePressEvent.hpp"
+#include "Events/MouseReleaseEvent.hpp"
+#include "Events/WindowResizeEvent.hpp"
+#include "Events/WindowCloseEvent.hpp"
+#include "Events/ButtonClickEvent.hpp"
+#include "Events/GamePauseEvent.hpp"
+#include "Events/GameOverEvent.hpp"
+
+const char* EventJournalRecord::getTypeName(const uint8_t& type) {
+    switch (type) {
+    case COLLISION:     return "COLLISION";
+    case KEY_PRESS:     return "KEY_PRESS";
+    case KEY_RELEASE:   return "KEY_RELEASE";
+    case MOUSE_MOVE:    return "MOUSE_MOVE";
+    case MOUSE_PRESS:   return "MOUSE_PRESS";
+    case MOUSE_RELEASE: return "MOUSE_RELEASE";
+    case WINDOW_RESIZE: return "WINDOW_RESIZE";
+    case WINDOW_CLOSE:  return "WINDOW_CLOSE";
+    case BUTTON_CLICK:  return "BUTTON_CLICK";
+    case GAME_PAUSE:    return "GAME_PAUSE";
+    case GAME_OVER:     return "GAME_OVER";
+    default:            return "OTHER";
+    }
+}
+
+EventJournal::EventJournal() :
+    _file(nullptr),
+    _capacity(0),
+    _numDropped(0),
+    _closing(false)
+{}
+
+EventJournal::~EventJournal() {
+    close();
+}
+
+bool EventJournal::open(const std::string& filename, const size_t& recordsPerFrame) {
+
+    assert(!isOpen());
+    assert(recordsPerFrame > 0);
+
+    _file = std::fopen(filename.c_str(), "wb");
+    if (!_file)
+        return false;
+
+    // write the header
+    const uint32_t header[2] = {VERSION, sizeof(EventJournalRecord)};
+    std::fwrite("GBEJ", 1, 4, _file);
+    std::fwrite(header, sizeof(uint32_t), 2, _file);
+
+    // allocate all buffers up front so that recording never has to allocate
+    _capacity = recordsPerFrame;
+    _activeBuffer.reserve(_capacity);
+    _pendingBuffer.reserve(_capacity);
+    _writingBuffer.reserve(_capacity);
+    _numDropped = 0;
+
+    // start the writer thread
+    _closing = false;
+    _writerThread = std::thread(&EventJournal::writerLoop, this);
+
+    return true;
+}
+
+void EventJournal::close() {
+
+    if (!isOpen())
+        return;
+
+    // Hand over whatever is left. The writer thread might still have a batch pending, so wait for
+    // it to pick that one up first.
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _condition.wait(lock, [this]() { return _pendingBuffer.empty(); });
+        std::swap(_activeBuffer, _pendingBuffer);
+        _closing = true;
+    }
+    _condition.notify_all();
+
+    // the writer thread writes the final batch before exiting
+    _writerThread.join();
+
+    std::fclose(_file);
+    _file = nullptr;
+}
+
+void EventJournal::record(const unsigned long& tick, const Event& event) {
+
+    assert(isOpen());
+
+    // don't let the buffer grow past its capacity, that would mean allocating
+    if (_activeBuffer.size() >= _capacity) {
+        ++_numDropped;
+        return;
+    }
+
+    EventJournalRecord record;
+    std::memset(&record, 0, sizeof(record));
+    record.tick = (uint32_t)tick;
+
+    const EventType& type = event.getType();
+
+    if (type == CollisionEvent::TYPE) {
+        const CollisionEvent& e = static_cast<const CollisionEvent&>(event);
+        record.type = EventJournalRecord::COLLISION;
+        record.actorTypes[0] = (uint8_t)e.actorA->getType();
+        record.actorTypes[1] = (uint8_t)e.actorB->getType();
+        record.values[0] = e.position.x;
+        record.values[1] = e.position.y;
+        record.values[2] = e.normalAngle;
+
+    } else if (type == KeyPressEvent::TYPE) {
+        record.type = EventJournalRecord::KEY_PRESS;
+        record.code = static_cast<const KeyPressEvent&>(event).key;
+
+    } else if (type == KeyReleaseEvent::TYPE) {
+        record.type = EventJournalRecord::KEY_RELEASE;
+        record.code = static_cast<const KeyReleaseEvent&>(event).key;
+
+    } else if (type == MouseMoveEvent::TYPE) {
+        const MouseMoveEvent& e = static_cast<const MouseMoveEvent&>(event);
+        record.type = EventJournalRecord::MOUSE_MOVE;
+        record.values[0] = e.graphical.x;
+        record.values[1] = e.graphical.y;
+
+    } else if (type == MousePressEvent::TYPE) {
+        const MousePressEvent& e = static_cast<const MousePressEvent&>(event);
+        record.type = EventJournalRecord::MOUSE_PRESS;
+        record.code = e.button;
+        record.values[0] = e.graphical.x;
+        record.values[1] = e.graphical.y;
+
+    } else if (type == MouseReleaseEvent::TYPE) {
+        const MouseReleaseEvent& e = static_cast<const MouseReleaseEvent&>(event);
+        record.type = EventJournalRecord::MOUSE_RELEASE;
+        record.code = e.button;
+        record.values[0] = e.graphical.x;
+        record.values[1] = e.graphical.y;
+
+    } else if (type == WindowResizeEvent::TYPE) {
+        const WindowResizeEvent& e = static_cast<const WindowResizeEvent&>(event);
+        record.type = EventJournalRecord::WINDOW_RESIZE;
+        record.values[0] = e.width;
+        record.values[1] = e.height;
+
+    } else if (type == WindowCloseEvent::TYPE) {
+        record.type = EventJournalRecord::WINDOW_CLOSE;
+
+    } else if (type == ButtonClickEvent::TYPE) {
+        record.type = EventJournalRecord::BUTTON_CLICK;
+
+    } else if (type == GamePauseEvent::TYPE) {
+        record.type = EventJournalRecord::GAME_PAUSE;
+        record.code = static_cast<const GamePauseEvent&>(event).action ==
+                GamePauseEvent::ACTION::PAUSE ? 0 : 1;
+
+    } else if (type == GameOverEvent::TYPE) {
+        record.type = EventJournalRecord::GAME_OVER;
+
+    } else {
+        record.type = EventJournalRecord::OTHER;
+    }
+
+    _activeBuffer.push_back(record);
+}
+
+void EventJournal::flush() {
+
+    assert(isOpen());
+
+    if (_activeBuffer.empty())
+        return;
+
+    // Don't wait if the writer thread is busy with the pending buffer; just try again next frame.
+    std::unique_lock<std::mutex> lock(_mutex, std::try_to_lock);
+    if (!lock.owns_lock() || !_pendingBuffer.empty())
+        return;
+
+    std::swap(_activeBuffer, _pendingBuffer);
+    lock.unlock();
+    _condition.notify_all();
+}
+
+void EventJournal::writerLoop() {
+
+    while (true) {
+
+        // wait for a batch of records, take it, and let the main thread know that it's been taken
+        bool closing;
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _condition.wait(lock, [this]() { return !_pendingBuffer.empty() || _closing; });
+            std::swap(_pendingBuffer, _writingBuffer);
+            closing = _closing;
+        }
+        _condition.notify_all();
+
+        // write the batch outside of the lock
+        if (!_writingBuffer.empty()) {
+            std::fwrite(_writingBuffer.data(), sizeof(EventJournalRecord), _writingBuffer.size(),
+                    _file);
+            std::fflush(_file);
+            _writingBuffer.clear();
+        }
+
+        if (closing)
+            return;
+    }
+}
@@ -3,6 +3,8 @@
 #include <cassert>
 #include <algorithm>
 #include <iostream>
+#include <iomanip>
+#include <chrono>
 
 #include "EventMessenger.hpp"
 
@@ -22,13 +24,41 @@ void EventMessenger::removeListener(const EventType& eventType, const EventListe
 
 void EventMessenger::triggerEvent(const Event& event) {
 
-    // Copy the list of listeners to call. Very important that this is copied, as using the actual
-    // list could segfualt if the list changes during iteration.
-    ListenerList listenerList = _listeners[event.getType()];
+    if (_statsEnabled)
+        ++_stats[event.getType()].numTriggered;
 
-    // iterate through list and call all listeners
-    for (const EventListener*& listener : listenerList) 
-        (*listener)(event);
+    dispatchEvent(event);
+}
+
+void EventMessenger::printStats(std::ostream& out) const {
+
+    std::ios::fmtflags flags = out.flags();
+    std::streamsize precision = out.precision();
+
+    out << "event statistics over " << _frameCount << " frames, at most " << _maxQueuedPerFrame
+            << " queued events in one frame" << std::endl;
+    out << std::left << std::setw(20) << "event" << std::right
+            << std::setw(12) << "triggered"
+            << std::setw(12) << "queued"
+            << std::setw(12) << "max/frame"
+            << std::setw(12) << "listeners"
+            << std::setw(12) << "total ms"
+            << std::setw(12) << "max ms" << std::endl;
+
+    for (auto& pair : _stats) {
+        const EventStats& stats = pair.second;
+        out << std::left << std::setw(20) << getEventTypeName(pair.first) << std::right
+                << std::setw(12) << stats.numTriggered
+                << std::setw(12) << stats.numQueued
+                << std::setw(12) << stats.maxQueuedPerFrame
+                << std::setw(12) << stats.numListenerCalls
+                << std::setw(12) << std::fixed << std::setprecision(3)
+                << stats.totalHandlerTime * 1000.0
+                << std::setw(12) << stats.maxHandlerTime * 1000.0 << std::endl;
+    }
+
+    out.flags(flags);
+    out.precision(precision);
 }
 
 void EventMessenger::triggerQueuedEvents() {
@@ -36,12 +66,66 @@ void EventMessenger::triggerQueuedEvents() {
     // switch first and second queues
     std::swap(_eventQueues.at(0), _eventQueues.at(1));
 
+    // keep track of how many events are triggered from the queue this frame
+    ++_frameCount;
+    if (_statsEnabled) {
+
+        _maxQueuedPerFrame = std::max(_maxQueuedPerFrame, (unsigned long)_eventQueues.at(0).size());
+
+        for (auto& pair : _stats)
+            pair.second.queuedThisFrame = 0;
+        for (std::shared_ptr<Event>& event : _eventQueues.at(0))
+            ++_stats[event->getType()].queuedThisFrame;
+        for (auto& pair : _stats)
+            pair.second.maxQueuedPerFrame = std::max(pair.second.maxQueuedPerFrame,
+                    pair.second.queuedThisFrame);
+    }
+
     // trigger all events in first queue; after event is triggered, free its memory
     for (std::shared_ptr<Event>& event : _eventQueues.at(0)) {
-        triggerEvent(*event);
+        dispatchEvent(*event);
         event.reset();
     }
     
     // clear first queue
     _eventQueues.at(0).clear();
+
+    // this is the end of the frame, so let the journal write what it has recorded
+    if (_journal)
+        _journal->flush();
+}
+
+void EventMessenger::dispatchEvent(const Event& event) {
+
+    if (_journal)
+        _journal->record(_frameCount, event);
+
+    // Copy the list of listeners to call. Very important that this is copied, as using the actual
+    // list could segfualt if the list changes during iteration.
+    ListenerList listenerList = _listeners[event.getType()];
+
+    // if stats aren't being collected, then just call all the listeners
+    if (!_statsEnabled) {
+        for (const EventListener*& listener : listenerList) 
+            (*listener)(event);
+        return;
+    }
+
+    // Otherwise, time each of the listeners. Get the stats entry after the listeners are called,
+    // since a listener may trigger other events and cause a rehash of the stats map.
+    typedef std::chrono::steady_clock Clock;
+    double totalTime = 0.0;
+    double maxTime = 0.0;
+    for (const EventListener*& listener : listenerList) {
+        Clock::time_point start = Clock::now();
+        (*listener)(event);
+        double time = std::chrono::duration<double>(Clock::now() - start).count();
+        totalTime += time;
+        maxTime = std::max(maxTime, time);
+    }
+
+    EventStats& stats = _stats[event.getType()];
+    stats.numListenerCalls += listenerList.size();
+    stats.totalHandlerTime += totalTime;
+    stats.maxHandlerTime = std::max(stats.maxHandlerTime, maxTime);
 }
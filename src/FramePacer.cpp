@@ -0,0 +1,132 @@
+#include <cassert>
+#include <cmath>
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <iostream>
+#include <iomanip>
+
+#include "FramePacer.hpp"
+
+FramePacer::FramePacer() :
+    _targetRate(0.0f),
+    _period(Clock::duration::zero()),
+    _started(false),
+    _sleepError(0.001),
+    _sleepErrorDeviation(0.0005),
+    _MIN_SPIN_TIME(0.0002),
+    _MAX_SPIN_TIME(0.004),
+    _numFrames(0),
+    _totalFrameTime(0.0),
+    _totalSquaredFrameTime(0.0),
+    _minFrameTime(0.0),
+    _maxFrameTime(0.0),
+    _numLateFrames(0),
+    _totalSpinTime(0.0)
+{}
+
+void FramePacer::setTargetRate(const float& framesPerSecond) {
+
+    assert(framesPerSecond >= 0.0f);
+
+    _targetRate = framesPerSecond;
+    _period = framesPerSecond > 0.0f ?
+            std::chrono::duration_cast<Clock::duration>(
+            std::chrono::duration<double>(1.0 / framesPerSecond)) :
+            Clock::duration::zero();
+
+    // start pacing from the next frame
+    _nextFrame = Clock::now() + _period;
+}
+
+void FramePacer::wait() {
+
+    if (_targetRate > 0.0f) {
+
+        // If the game fell behind by more than a frame, then don't try to catch up with a burst of
+        // frames, just start pacing again from now.
+        Clock::time_point now = Clock::now();
+        if (now > _nextFrame + _period)
+            _nextFrame = now;
+
+        // sleep until shortly before the frame is due, leaving as much time as sleeping usually
+        // wakes up late, plus some margin
+        double spinTime = std::min(std::max(_sleepError + 2.0 * _sleepErrorDeviation,
+                _MIN_SPIN_TIME), _MAX_SPIN_TIME);
+        Clock::duration sleepTime = _nextFrame - now -
+                std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(spinTime));
+        if (sleepTime > Clock::duration::zero())
+            sleep(sleepTime);
+
+        // spin for the rest
+        Clock::time_point spinStart = Clock::now();
+        while (Clock::now() < _nextFrame)
+            std::this_thread::yield();
+        _totalSpinTime += std::chrono::duration<double>(Clock::now() - spinStart).count();
+
+        _nextFrame += _period;
+    }
+
+    // measure the time since the previous frame
+    Clock::time_point now = Clock::now();
+    if (_started) {
+        double frameTime = std::chrono::duration<double>(now - _lastFrame).count();
+        _minFrameTime = _numFrames == 0 ? frameTime : std::min(_minFrameTime, frameTime);
+        _maxFrameTime = std::max(_maxFrameTime, frameTime);
+        _totalFrameTime += frameTime;
+        _totalSquaredFrameTime += frameTime * frameTime;
+        if (_targetRate > 0.0f && frameTime > 1.0 / _targetRate + 0.001)
+            ++_numLateFrames;
+        ++_numFrames;
+    }
+    _lastFrame = now;
+    _started = true;
+}
+
+void FramePacer::restart() {
+    _nextFrame = Clock::now() + _period;
+    _started = false;
+}
+
+void FramePacer::printStats(std::ostream& out) const {
+
+    out << "frame statistics over " << _numFrames << " frames";
+    if (_targetRate > 0.0f)
+        out << ", paced to " << _targetRate << " per second";
+    out << std::endl;
+
+    if (_numFrames == 0)
+        return;
+
+    double mean = _totalFrameTime / _numFrames;
+    double deviation = std::sqrt(std::max(_totalSquaredFrameTime / _numFrames - mean * mean, 0.0));
+    double target = _targetRate > 0.0f ? 1.0 / _targetRate : mean;
+    double maxJitter = std::max(_maxFrameTime - target, target - _minFrameTime);
+
+    std::ios::fmtflags flags = out.flags();
+    std::streamsize precision = out.precision();
+
+    out << std::fixed << std::setprecision(3)
+            << "mean frame time " << mean * 1000.0 << " ms, standard deviation "
+            << deviation * 1000.0 << " ms" << std::endl
+            << "min " << _minFrameTime * 1000.0 << " ms, max " << _maxFrameTime * 1000.0
+            << " ms, max jitter " << maxJitter * 1000.0 << " ms" << std::endl;
+    if (_targetRate > 0.0f)
+        out << _numLateFrames << " frames were over 1 ms late, spent "
+                << _totalSpinTime / _numFrames * 1000.0 << " ms per frame spinning" << std::endl;
+
+    out.flags(flags);
+    out.precision(precision);
+}
+
+void FramePacer::sleep(const Clock::duration& duration) {
+
+    Clock::time_point start = Clock::now();
+    std::this_thread::sleep_for(duration);
+    double error = std::chrono::duration<double>(Clock::now() - start - duration).count();
+
+    // exponential moving averages of the error and its deviation
+    const double weight = 0.1;
+    _sleepErrorDeviation += weight * (std::abs(error - _sleepError) - _sleepErrorDeviation);
+    _sleepError += weight * (error - _sleepError);
+}
@@ -1,12 +1,21 @@
 #include <cassert>
 #include <memory>
 #include <iostream>
+#include <iomanip>
+#include <vector>
+#include <chrono>
 
 #include <SFML/Graphics.hpp>
 
+#ifdef SFML_SYSTEM_LINUX
+#include <X11/Xlib.h>
+#endif
+
 #include "Game.hpp"
 #include "Globals.hpp"
 #include "ResourceCache.hpp"
+#include "ObstacleFactory.hpp"
+#include "NPCFactory.hpp"
 #include "EventListener.hpp"
 #include "Event.hpp"
 #include "Events/WindowResizeEvent.hpp"
@@ -20,8 +29,24 @@
 
 Game::Game() :
     _initialized(false),
+    _renderThreadEnabled(false),
+    _rendering(false),
+    _verticalSyncEnabled(false),
+    _hasFocus(true),
+    _needsRedraw(true),
+    _IDLE_POLL_TIME(sf::milliseconds(10)),
+    _IDLE_REDRAW_TIME(sf::milliseconds(500)),
+    _inputThreadEnabled(false),
+    _numKeyPresses(0),
+    _numTimedKeyPresses(0),
+    _totalPollDelay(0.0),
+    _totalInputLatency(0.0),
+    _maxInputLatency(0.0),
+    _TEXTURE_UPLOADS_PER_FRAME(2),
     _timeDelta(0.0f)
 {
+    _framePacer.setTargetRate(60.0f);
+
     // init event listeners
     _windowResizeListener.init(&Game::windowResizeHandler, this);
     _windowCloseListener.init(&Game::windowCloseHandler, this);
@@ -33,6 +58,9 @@ Game::Game() :
 
 Game::~Game() {
 
+    // stop drawing before the window goes away
+    stopRenderThread();
+
     // remove listeners
     eventMessenger.removeListener(WindowCloseEvent::TYPE, _windowCloseListener);
     eventMessenger.removeListener(WindowResizeEvent::TYPE, _windowResizeListener);
@@ -44,6 +72,29 @@ Game::~Game() {
     _currentActivity = nullptr;
 }
 
+void Game::setRenderThreadEnabled(const bool& enabled) {
+    assert(!_initialized);
+    _renderThreadEnabled = enabled;
+}
+
+void Game::setInputThreadEnabled(const bool& enabled) {
+    assert(!_initialized);
+    _inputThreadEnabled = enabled;
+}
+
+void Game::setFramerateLimit(const float& framesPerSecond) {
+    _framePacer.setTargetRate(framesPerSecond);
+}
+
+void Game::setVerticalSyncEnabled(const bool& enabled) {
+    assert(!_initialized);
+    _verticalSyncEnabled = enabled;
+}
+
+void Game::setCourseFile(const CourseFile* courseFile) {
+    _playingActivity.setCourseFile(courseFile);
+}
+
 void Game::init() {
 
     _initialized = true;
@@ -52,6 +103,13 @@ void Game::init() {
     sf::ContextSettings settings;
     settings.antialiasingLevel = 4;
 
+#ifdef SFML_SYSTEM_LINUX
+    // The input thread reads the keyboard through Xlib while this thread polls the window, which
+    // Xlib only allows if it's made thread safe before anything else uses it.
+    if (_inputThreadEnabled)
+        XInitThreads();
+#endif
+
     // make the window
     _window = std::make_shared<sf::RenderWindow>(
         sf::VideoMode(NATIVE_RESOLUTION.x, NATIVE_RESOLUTION.y, 32),
@@ -61,97 +119,247 @@ void Game::init() {
     );
     _window->setActive();
     _window->setKeyRepeatEnabled(false);
-
-    // initialize resource cache
-    resourceCache.init();
-
-    // init playing activity
-    _playingActivity.init(*_window.get());
-
-    // set current activity to playing activity
-    _currentActivity = &_playingActivity;
+    _window->setVerticalSyncEnabled(_verticalSyncEnabled);
+    _view = _window->getDefaultView();
+
+    // Start loading resources in the background, and show the loading activity in the meantime. The
+    // factories can resolve their resource handles right away.
+    resourceCache.startLoading();
+    ObstacleFactory::init();
+    NPCFactory::init();
+    _loadingActivity.init();
+    _currentActivity = &_loadingActivity;
+
+    // Time the keys that make the bird fly and poop precisely, if enabled. Other keys work as well,
+    // they're just timed to the frame.
+    if (_inputThreadEnabled)
+        _inputSampler.start({sf::Keyboard::Space, sf::Keyboard::Up, sf::Keyboard::W});
 
     // restart game clock
     _clock.restart();
+    _lastUpdate = InputSampler::Clock::now();
 }
 
 bool Game::update() {
 
     assert(_initialized);
 
-    // poll events
+    // While idle, nothing changes until there's input, so wait for it instead of pacing. Don't
+    // count the time spent waiting as part of the frame. If nothing happens for a while, the frame
+    // is redrawn anyway, in case the window's contents were lost.
     sf::Event event;
-    while (_window->pollEvent(event)) {
-        
-        switch (event.type) {
-
-        // queue a WindowCloseEvent if the window was requested to be closed
-        case sf::Event::Closed:
-            eventMessenger.queueEvent(WindowCloseEvent());
-            break;
-        
-        // trigger a pause event if the window lost focus
-        case sf::Event::LostFocus:
-            eventMessenger.triggerEvent(GamePauseEvent(GamePauseEvent::ACTION::PAUSE));
-            break;
-
-        // trigger a pause event and queue a resize event if the window is resized
-        case sf::Event::Resized:
-            eventMessenger.triggerEvent(GamePauseEvent(GamePauseEvent::ACTION::PAUSE));
-            eventMessenger.queueEvent(WindowResizeEvent(event));
-            break;
-
-        case sf::Event::KeyPressed:
-            eventMessenger.triggerEvent(KeyPressEvent(event.key.code));
-            break;
-        
-        case sf::Event::KeyReleased:
-            eventMessenger.triggerEvent(KeyReleaseEvent(event.key.code));
-            break;
-        
-        case sf::Event::MouseMoved:
-            { // need a block here because we declare a variable
-                sf::Vector2i pixelCoord(event.mouseMove.x, event.mouseMove.y);
-                eventMessenger.triggerEvent(MouseMoveEvent(pixelCoord,
-                        _window->mapPixelToCoords(pixelCoord)));
-            }
-            break;
-        
-        case sf::Event::MouseButtonPressed:
-            {
-                sf::Vector2i pixelCoord(event.mouseButton.x, event.mouseButton.y);
-                eventMessenger.triggerEvent(MousePressEvent(event.mouseButton.button,
-                        pixelCoord, _window->mapPixelToCoords(pixelCoord)));
-            }
-            break;
-
-        case sf::Event::MouseButtonReleased:
-            {
-                sf::Vector2i pixelCoord(event.mouseButton.x, event.mouseButton.y);
-                eventMessenger.triggerEvent(MouseReleaseEvent(event.mouseButton.button,
-                        pixelCoord, _window->mapPixelToCoords(pixelCoord)));
-            }
-            break;
+    if (isIdle()) {
+        if (waitEvent(event, _IDLE_REDRAW_TIME))
+            handleEvent(event);
+        else
+            _needsRedraw = true;
+        _framePacer.restart();
+        _clock.restart();
+        _lastUpdate = InputSampler::Clock::now();
+    } else {
+        // wait until it's time for the next frame, so that the game doesn't run faster than it
+        // needs to
+        _framePacer.wait();
+    }
+
+    // poll events
+    while (_window->pollEvent(event))
+        handleEvent(event);
+
+    // Keep loading resources if they're not done yet. Once they are, the playing activity can be
+    // initialized, since it needs the resources, and the render thread can take over drawing. After
+    // that, unused textures are evicted between frames if there's a texture budget. Without lazy
+    // loading or a budget, the cache never changes again anyway, so it's frozen to let jobs get
+    // resources from worker threads.
+    if (_currentActivity == &_loadingActivity) {
+        if (resourceCache.finishLoading(_TEXTURE_UPLOADS_PER_FRAME)) {
+            _playingActivity.init(_jobSystem);
+            _currentActivity = &_playingActivity;
+            if (_renderThreadEnabled)
+                startRenderThread();
+            else if (!resourceCache.isLazyLoading() && resourceCache.getTextureBudget() == 0)
+                resourceCache.freeze();
         }
+    } else {
+        resourceCache.collectGarbage();
     }
 
     // determine time delta and divert update call to current activity
     float timeDelta = _clock.restart().asSeconds();
+    _lastUpdate = InputSampler::Clock::now();
     _currentActivity->update(timeDelta);
 
+    // the key presses of this frame are in the simulation now, measure how long that took
+    InputSampler::Clock::time_point now = InputSampler::Clock::now();
+    for (const InputSampler::Clock::time_point& keyPress : _pendingKeyPresses) {
+        double latency = std::chrono::duration<double>(now - keyPress).count();
+        _totalInputLatency += latency;
+        _maxInputLatency = std::max(_maxInputLatency, latency);
+    }
+    _pendingKeyPresses.clear();
+
     // trigger all queued events
     eventMessenger.triggerQueuedEvents();
+
+    // redraw every frame unless idle, in which case only input can change what's on the screen
+    if (!isIdle())
+        _needsRedraw = true;
     
     return _window->isOpen();
 }
 
-void Game::draw() const {
+bool Game::isIdle() const {
+    return _currentActivity == &_playingActivity && (_playingActivity.isPaused() || !_hasFocus);
+}
+
+bool Game::waitEvent(sf::Event& event, const sf::Time& timeout) {
+
+    // This is what sf::Window::waitEvent() does, except that it gives up after the timeout. There's
+    // nothing to time precisely while waiting, so the input thread is paused meanwhile.
+    _inputSampler.setPaused(true);
+    sf::Clock clock;
+    bool hasEvent = false;
+    while (!(hasEvent = _window->pollEvent(event)) && clock.getElapsedTime() < timeout)
+        sf::sleep(_IDLE_POLL_TIME);
+    _inputSampler.setPaused(false);
+    return hasEvent;
+}
+
+float Game::getKeyAge(const sf::Keyboard::Key& key, const bool& pressed) {
+
+    InputSampler::Clock::time_point now = InputSampler::Clock::now();
+    bool wasTimed = false;
+    InputSampler::Clock::time_point time = _inputSampler.isRunning() ?
+            _inputSampler.takeTime(key, pressed, _lastUpdate, wasTimed) : _lastUpdate;
+
+    if (pressed) {
+        ++_numKeyPresses;
+        if (wasTimed) {
+            ++_numTimedKeyPresses;
+            _totalPollDelay += std::chrono::duration<double>(now - time).count();
+            _pendingKeyPresses.push_back(time);
+        }
+    }
+
+    return std::chrono::duration<float>(now - time).count();
+}
+
+void Game::handleEvent(const sf::Event& event) {
+
+    // anything that happens may change what's on the screen
+    _needsRedraw = true;
+
+    switch (event.type) {
+
+    // queue a WindowCloseEvent if the window was requested to be closed
+    case sf::Event::Closed:
+        eventMessenger.queueEvent(WindowCloseEvent());
+        break;
+    
+    // trigger a pause event if the window lost focus
+    case sf::Event::LostFocus:
+        _hasFocus = false;
+        eventMessenger.triggerEvent(GamePauseEvent(GamePauseEvent::ACTION::PAUSE));
+        break;
+
+    case sf::Event::GainedFocus:
+        _hasFocus = true;
+        break;
+
+    // trigger a pause event and queue a resize event if the window is resized
+    case sf::Event::Resized:
+        eventMessenger.triggerEvent(GamePauseEvent(GamePauseEvent::ACTION::PAUSE));
+        eventMessenger.queueEvent(WindowResizeEvent(event));
+        break;
+
+    case sf::Event::KeyPressed:
+        eventMessenger.triggerEvent(KeyPressEvent(event.key.code,
+                getKeyAge(event.key.code, true)));
+        break;
+    
+    case sf::Event::KeyReleased:
+        eventMessenger.triggerEvent(KeyReleaseEvent(event.key.code,
+                getKeyAge(event.key.code, false)));
+        break;
+    
+    case sf::Event::MouseMoved:
+        { // need a block here because we declare a variable
+            sf::Vector2i pixelCoord(event.mouseMove.x, event.mouseMove.y);
+            eventMessenger.triggerEvent(MouseMoveEvent(pixelCoord,
+                    _window->mapPixelToCoords(pixelCoord, _view)));
+        }
+        break;
+    
+    case sf::Event::MouseButtonPressed:
+        {
+            sf::Vector2i pixelCoord(event.mouseButton.x, event.mouseButton.y);
+            eventMessenger.triggerEvent(MousePressEvent(event.mouseButton.button,
+                    pixelCoord, _window->mapPixelToCoords(pixelCoord, _view)));
+        }
+        break;
+
+    case sf::Event::MouseButtonReleased:
+        {
+            sf::Vector2i pixelCoord(event.mouseButton.x, event.mouseButton.y);
+            eventMessenger.triggerEvent(MouseReleaseEvent(event.mouseButton.button,
+                    pixelCoord, _window->mapPixelToCoords(pixelCoord, _view)));
+        }
+        break;
+    }
+}
+
+void Game::printInputStats(std::ostream& out) const {
+
+    out << "input statistics: " << _numKeyPresses << " key presses, " << _numTimedKeyPresses
+            << " timed by the input thread" << std::endl;
+    if (_numTimedKeyPresses == 0)
+        return;
+
+    std::ios::fmtflags flags = out.flags();
+    std::streamsize precision = out.precision();
+
+    out << std::fixed << std::setprecision(3)
+            << "timed key presses were polled " << _totalPollDelay / _numTimedKeyPresses * 1000.0
+            << " ms after they happened on average, and reached the simulation after "
+            << _totalInputLatency / _numTimedKeyPresses * 1000.0 << " ms on average, "
+            << _maxInputLatency * 1000.0 << " ms at most" << std::endl;
+
+    out.flags(flags);
+    out.precision(precision);
+}
+
+void Game::printUpdateStats(std::ostream& out) const {
+    _playingActivity.printUpdateStats(out);
+}
+
+void Game::draw() {
 
     assert(_initialized);
 
-    // clear the window, let the current activity draw onto the window, then display the window
+    // keep showing the last frame if nothing changed since it was drawn
+    if (!_needsRedraw)
+        return;
+    _needsRedraw = false;
+
+    // let the current activity record itself into a fresh snapshot
+    RenderSnapshot& snapshot = _snapshots.getWriteBuffer();
+    snapshot.clear();
+    snapshot.setView(_view);
+    _currentActivity->draw(snapshot);
+
+    // hand the snapshot to the render thread if it's running
+    if (_renderThread.joinable()) {
+        _snapshots.publish();
+        {
+            std::lock_guard<std::mutex> lock(_renderMutex);
+        }
+        _renderCondition.notify_one();
+        return;
+    }
+
+    // otherwise clear the window, draw the snapshot onto it, then display the window
     _window->clear();
-    _currentActivity->draw(*_window.get());
+    snapshot.draw(*_window.get());
     _window->display();
 }
 
@@ -177,20 +385,78 @@ void Game::windowResizeHandler(const Event& e) {
         // window is wider than it should be
         idealSize.x = windowSize.y * NATIVE_ASPECT_RATIO;
     
-    // change the window's viewport to match idealSize -- this requires setting the whole view
-    sf::View windowView = _window->getView();
-    windowView.setViewport(sf::FloatRect(
+    // Change the viewport to match idealSize. The window gets the new view with the next snapshot
+    // that's drawn.
+    _view.setViewport(sf::FloatRect(
         (windowSize.x - idealSize.x) / 2.0f / windowSize.x,
         (windowSize.y - idealSize.y) / 2.0f / windowSize.y,
         idealSize.x / windowSize.x,
         idealSize.y / windowSize.y
     ));
-    _window->setView(windowView);
 }
 
 void Game::windowCloseHandler(const Event& e) {
     
     assert(e.getType() == WindowCloseEvent::TYPE);
 
+    stopRenderThread();
     _window->close();
 }
+
+void Game::startRenderThread() {
+
+    assert(!_renderThread.joinable());
+
+    // Nothing may be evicted or loaded from here on, since a snapshot that's being drawn can refer
+    // to any texture. Text is laid out when it's recorded into a snapshot, so the render thread
+    // only draws finished glyphs and never uses a font while this thread measures text with it.
+    resourceCache.freeze();
+
+    // the OpenGL context can only be active in one thread at a time
+    _window->setActive(false);
+
+    _rendering = true;
+    _renderThread = std::thread(&Game::render, this);
+}
+
+void Game::stopRenderThread() {
+
+    if (!_renderThread.joinable())
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(_renderMutex);
+        _rendering = false;
+    }
+    _renderCondition.notify_one();
+    _renderThread.join();
+
+    // take the OpenGL context back
+    _window->setActive(true);
+}
+
+void Game::render() {
+
+    _window->setActive(true);
+
+    while (true) {
+
+        // sleep until a snapshot is published, or the thread is stopped
+        {
+            std::unique_lock<std::mutex> lock(_renderMutex);
+            _renderCondition.wait(lock, [this]() {
+                return !_rendering || _snapshots.hasPublished();
+            });
+            if (!_rendering)
+                break;
+        }
+
+        // draw the latest snapshot
+        _snapshots.acquire();
+        _window->clear();
+        _snapshots.getReadBuffer().draw(*_window.get());
+        _window->display();
+    }
+
+    _window->setActive(false);
+}
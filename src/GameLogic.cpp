@@ -2,8 +2,13 @@
 #include <vector>
 #include <memory>
 #include <iostream>
+#include <iomanip>
+#include <map>
 #include <math.h>
 #include <algorithm>
+#include <deque>
+#include <mutex>
+#include <random>
 
 #include <box2d/box2d.h>
 #include <box2d/b2_math.h>
@@ -16,6 +21,9 @@
 #include "Utils.hpp"
 #include "NPC.hpp"
 #include "NPCFactory.hpp"
+#include "CourseFile.hpp"
+#include "CourseGenerator.hpp"
+#include "TimerWheel.hpp"
 #include "Event.hpp"
 #include "Events/GamePauseEvent.hpp"
 #include "Events/CollisionEvent.hpp"
@@ -46,6 +54,9 @@ GameLogic::GameLogic() :
     _BIRD_POOP_DURATION(0.5f),
     _BIRD_MAX_POOPS(2),
     _POOP_DOWNWARD_VELOCITY(3.0f),
+    _lastPoopTime(0.0),
+    _poopTimer(TimerWheel::NO_TIMER),
+    _deathTimer(TimerWheel::NO_TIMER),
     _lastPoop(nullptr),
 
     _NPC_WALK_SPEED(2.0f),
@@ -56,8 +67,28 @@ GameLogic::GameLogic() :
 
     _SPAWN_LOCATION_X(NATIVE_RESOLUTION.x * METERS_PER_PIXEL + 5.0f),
     
-    _MAX_DIFFICULTY_TIME(50.0f)
-{}
+    _MAX_DIFFICULTY_TIME(50.0f),
+
+    _PLAN_AHEAD_METERS(NATIVE_RESOLUTION.x * METERS_PER_PIXEL * 3.0f),
+    _plannedLength(0.0f),
+    _planForDemo(true),
+    _plannerGenerator(std::random_device()()),
+    _courseGenerator(std::random_device()()),
+    _nextMapGenerator(std::random_device()()),
+    _courseFile(nullptr),
+    _courseFileIndex(0),
+
+    _OFFSCREEN_MARGIN(2.0f)
+{
+    _nextMap.rightmost = 0.0f;
+
+    // NPCs stand on the docks and the ground, so they're still simulated off the screen; nothing
+    // else does anything there that's worth simulating
+    setOffscreenPolicy(PhysicalActor::TYPE::NPC, OFFSCREEN_POLICY::REDUCED);
+    setOffscreenPolicy(PhysicalActor::TYPE::POOP, OFFSCREEN_POLICY::FROZEN);
+    setOffscreenPolicy(PhysicalActor::TYPE::GENERIC_OBSTACLE, OFFSCREEN_POLICY::FROZEN);
+    setOffscreenPolicy(PhysicalActor::TYPE::PROJECTILE, OFFSCREEN_POLICY::FROZEN);
+}
 
 GameLogic::~GameLogic() {
 
@@ -68,6 +99,7 @@ GameLogic::~GameLogic() {
     // remove every actor, including the big ground
     removeAllFromWorld();
     _npcGround.reset();
+    _playableBirdActor.setTimerWheel(nullptr);
 
     // free world memory
     _world.reset();
@@ -94,11 +126,22 @@ void GameLogic::init() {
 
     // initialize playable bird
     _playableBirdActor.init();
+    _playableBirdActor.setTimerWheel(&_timers);
+
+    // create the actors that get recycled on every reset
+    createMap();
 
     // set state to demo
     toDemo();
 }
 
+void GameLogic::setCourseFile(const CourseFile* courseFile) {
+
+    assert(!courseFile || courseFile->isOpen());
+
+    _courseFile = courseFile;
+}
+
 void GameLogic::update(const float& timeDelta) {
 
     assert(_initialized);
@@ -120,13 +163,32 @@ void GameLogic::update(const float& timeDelta) {
     removeOutOfBoundsActors();
     generateNewActors(timeDelta);
 
-    // update actors
+    // while the game over screen is up, get the next map ready bit by bit
+    if (_state == GAME_OVER)
+        prepareNextMap(false);
+
+    // update actors, skipping what doesn't need to be done off the screen
     updateGround();
-    updatePlayableBird(timeDelta);
     updateNPCs(timeDelta);
-    
-    // increment physics
-    _world->Step(timeDelta, 8, 4);
+    updateOffscreenActors(timeDelta);
+
+    // Step the bird and the physics in pieces, split at the points where the bird's requests were
+    // made, so that e.g. the bird starts flying exactly when the key was pressed rather than at the
+    // start of the next update. A request that's timed before the one preceding it, e.g. because
+    // only the preceding one's time was measured precisely, is applied right after that one.
+    std::vector<BirdRequest> requests;
+    requests.swap(_birdRequests);
+    float stepped = 0.0f;
+    for (const BirdRequest& request : requests) {
+        float requestTime = clamp(timeDelta - request.age, 0.0f, timeDelta);
+        if (requestTime > stepped) {
+            stepWorld(requestTime - stepped);
+            stepped = requestTime;
+        }
+        applyBirdRequest(request.type);
+    }
+    if (timeDelta > stepped)
+        stepWorld(timeDelta - stepped);
 }
 
 void GameLogic::toDemo() {
@@ -136,14 +198,14 @@ void GameLogic::toDemo() {
     // set state, also the game should not be paused
     _state = DEMO;
     _isPaused = false;
+    _isGameOverQueued = false;
 
-    // remove all actors and create initial map
-    removeAllFromWorld();
-    createMap();
-
-    // playable bird should be behind all other objects
-    _playableBirdBody = addToWorld(_playableBirdActor, _BIRD_DEMO_POSITION, false, false);
+    // put the world back into its initial state, and plan the course ahead for the demo
+    resetMap();
+    discardPlannedCourse(true);
     _lastPoop = nullptr;
+    _timers.cancel(_poopTimer);
+    _timers.cancel(_deathTimer);
 
     // set bird to demo state
     _playableBirdActor.stopPooping();
@@ -156,21 +218,25 @@ void GameLogic::toDemo() {
     _totalTimePassed = 0.0;
     _playingTimePassed = 0.0;
     _difficulty = 0.0f;
+    _birdRequests.clear();
 }
 
 void GameLogic::toPlaying() {
 
     assert(_initialized);
 
-    // set state
+    // set state, the course that was planned for the demo isn't used for playing
     _state = PLAYING;
+    _isGameOverQueued = false;
+    discardPlannedCourse(false);
 
     // set bird to initial playing state
-    _timeSinceLastPoop = 0.0f;
+    restartPoopTimers();
     _numPoopsLeft = _BIRD_MAX_POOPS;
     _playerScore = 0;
     _playableBirdActor.stopPooping();
     _playableBirdActor.stopFlying();
+    _birdRequests.clear();
 
     // set initial values for bird's physical body
     _playableBirdBody->SetGravityScale(1.0f);
@@ -186,8 +252,10 @@ void GameLogic::toGameOver() {
 
     assert(_initialized);
 
-    // set the state to GAME_OVER
+    // set the state to GAME_OVER, the bird can't die twice
     _state = GAME_OVER;
+    _timers.cancel(_poopTimer);
+    _timers.cancel(_deathTimer);
 
     // set bird properties
     _playableBirdActor.stopPooping();
@@ -242,7 +310,7 @@ int GameLogic::getNumPoopsLeft() const {
 
 float GameLogic::getPoopTimeLeft() const {
     assert(_initialized);
-    return 1.0f - _timeSinceLastPoop / _BIRD_DEATH_TIME;
+    return 1.0f - (_timers.getTime() - _lastPoopTime) / _BIRD_DEATH_TIME;
 }
 
 int GameLogic::getPlayerScore() const {
@@ -255,28 +323,112 @@ float GameLogic::getDifficulty() const {
     return _difficulty;
 }
 
-void GameLogic::requestBirdStartFly() {
+void GameLogic::requestBirdStartFly(const float& age) {
 
     assert(_initialized);
 
     // only allow if state is PLAYING and the game is not paused
     if (_state == PLAYING && !_isPaused)
-        _playableBirdActor.startFlying();
+        _birdRequests.push_back({START_FLY, age});
 }
 
-void GameLogic::requestBirdStopFly() {
+void GameLogic::requestBirdStopFly(const float& age) {
 
     assert(_initialized);
     
-    // only allow if state is PLAYING; don't worry about if the game is paused
+    // only allow if state is PLAYING; don't worry about if the game is paused, the bird stops
+    // flying as soon as it's unpaused
     if (_state == PLAYING)
-        _playableBirdActor.stopFlying();
+        _birdRequests.push_back({STOP_FLY, age});
 }
 
-void GameLogic::requestBirdPoop() {
+void GameLogic::requestBirdPoop(const float& age) {
 
     assert(_initialized);
-    
+
+    // only allow if state is PLAYING and the game is not paused
+    if (_state == PLAYING && !_isPaused)
+        _birdRequests.push_back({POOP, age});
+}
+
+void GameLogic::setOffscreenPolicy(const PhysicalActor::TYPE& type,
+        const OFFSCREEN_POLICY& policy) {
+
+    assert(type != PhysicalActor::TYPE::PLAYABLE_BIRD && type != PhysicalActor::TYPE::GROUND);
+
+    _offscreenPolicies[type] = policy;
+}
+
+bool GameLogic::isSkippingUpdates(const PhysicalActor& actor) const {
+
+    assert(_initialized);
+
+    auto policy = _offscreenPolicies.find(actor.getType());
+    if (policy == _offscreenPolicies.end() || policy->second == OFFSCREEN_POLICY::FULL)
+        return false;
+
+    b2Body* body = getBody(&actor);
+    return body && !isOnScreen(body);
+}
+
+void GameLogic::printUpdateStats(std::ostream& out) const {
+
+    // count the bodies which are frozen right now, which should only be those that may come back
+    std::map<PhysicalActor::TYPE, std::size_t> numFrozen;
+    for (auto& pair : _physicalActors) {
+        if (pair.second->GetType() == b2_dynamicBody && !pair.second->IsEnabled())
+            ++numFrozen[pair.first->getType()];
+    }
+
+    out << "updates of off-screen actors" << std::endl;
+    out << std::left << std::setw(20) << "type" << std::setw(10) << "policy" << std::right
+            << std::setw(12) << "updates"
+            << std::setw(12) << "skipped"
+            << std::setw(12) << "frozen now" << std::endl;
+
+    for (auto& pair : _offscreenPolicies) {
+        const char* policyName = pair.second == OFFSCREEN_POLICY::FULL ? "FULL" :
+                pair.second == OFFSCREEN_POLICY::REDUCED ? "REDUCED" : "FROZEN";
+        auto stats = _updateStats.find(pair.first);
+        std::size_t numUpdates = stats == _updateStats.end() ? 0 : stats->second.numUpdates;
+        std::size_t numSkipped = stats == _updateStats.end() ? 0 : stats->second.numSkipped;
+        auto frozen = numFrozen.find(pair.first);
+        out << std::left << std::setw(20) << PhysicalActor::getTypeStr(pair.first)
+                << std::setw(10) << policyName << std::right
+                << std::setw(12) << numUpdates
+                << std::setw(12) << numSkipped
+                << std::setw(12) << (frozen == numFrozen.end() ? 0 : frozen->second) << std::endl;
+    }
+}
+
+b2Vec2 GameLogic::getOffsetToBird(const PhysicalActor& actor) const {
+
+    assert(_initialized);
+
+    b2Body* body = getBody(&actor);
+    assert(body && _playableBirdBody);
+
+    return _playableBirdBody->GetPosition() - body->GetPosition();
+}
+
+void GameLogic::applyBirdRequest(const BIRD_REQUEST& request) {
+
+    assert(_initialized);
+
+    // the state may have changed since the request was made
+    if (_state != PLAYING)
+        return;
+
+    if (request == START_FLY) {
+        _playableBirdActor.startFlying();
+        return;
+    }
+
+    if (request == STOP_FLY) {
+        _playableBirdActor.stopFlying();
+        return;
+    }
+
     // only poop if all of the following:
     //     - the state is PLAYING
     //     - the game is not paused
@@ -287,7 +439,7 @@ void GameLogic::requestBirdPoop() {
         // set variables to reflect poop start
         _playableBirdActor.startPooping();
         --_numPoopsLeft;
-        _timeSinceLastPoop = 0.0f;
+        restartPoopTimers();
 
         // Make a poop obstacle and give it a vertical velocity which will make it shoot downward
         // from the bird.
@@ -312,7 +464,7 @@ void GameLogic::requestNPCAction(NPC& npc, const NPC::ACTION& action, const floa
         if (_state != PLAYING)
             return;
 
-        float xDiff = npcBody->GetPosition().x - _playableBirdBody->GetPosition().x;
+        float xDiff = -getOffsetToBird(npc).x;
         if (action == NPC::ACTION::FINISH_THROW &&
                 (xDiff >= 0.0f ? xDiff <= _NO_THROW_ZONE_RIGHT : -xDiff <= _NO_THROW_ZONE_LEFT))
             return;
@@ -425,7 +577,7 @@ void GameLogic::handlePoopCollision(const CollisionEvent& e) {
         // If it didn't collide with an NPC, it's the last poop, and they're aren't any poops
         // left, then it's game over.
         } else if (poop == _lastPoop && _numPoopsLeft <= 0) {
-            eventMessenger.triggerEvent(GameOverEvent());
+            queueGameOver();
         }
     }
 
@@ -443,25 +595,83 @@ void GameLogic::handleBirdCollision(const CollisionEvent& e) {
         return;
 
     // the bird collided with something, so that's game over bro
-    eventMessenger.triggerEvent(GameOverEvent());
+    queueGameOver();
+}
+
+void GameLogic::queueGameOver() {
+
+    // The game is over once the queued event is handled at the end of the frame. Until then the
+    // state is still PLAYING, so the event mustn't be queued again.
+    if (!_isGameOverQueued) {
+        _isGameOverQueued = true;
+        eventMessenger.queueEvent(GameOverEvent());
+    }
 }
 
 void GameLogic::createMap() {
 
-    // create the ground objects
+    // create the ground objects, resetMap() puts them in place
     for (int i = 0; i < _NUM_GROUNDS; ++i) {
         _grounds.push_back(ObstacleFactory::makeGround(_GROUND_WIDTH_METERS));
-        addToWorld(*_grounds.back(), b2Vec2(_GROUND_WIDTH_METERS + i * _GROUND_WIDTH_METERS,
-                _GROUND_OFFSET_METERS + 0.01f));
+        addToWorld(*_grounds.back());
     }
     _npcGround = ObstacleFactory::makeNPCGround(_BIG_GROUND_WIDTH_METERS);
     addToWorld(*_npcGround, b2Vec2(NATIVE_RESOLUTION.x * METERS_PER_PIXEL / 2.0f,
             _GROUND_OFFSET_METERS), false);
 
-    // populate the screen with NPEs
-    _rightmostObstacleLocation = 0.0f;
-    while (_rightmostObstacleLocation < _SPAWN_LOCATION_X)
-        spawnNPE(b2Vec2(_rightmostObstacleLocation, _GROUND_OFFSET_METERS));
+    // create the playable bird, resetMap() puts it in place as well
+    _playableBirdBody = addToWorld(_playableBirdActor, _BIRD_DEMO_POSITION, false, false);
+}
+
+void GameLogic::resetMap() {
+
+    // get rid of everything but the grounds and the bird
+    removeSpawnedFromWorld();
+
+    // line the grounds up from the left of the screen, in the order they're in the list
+    int i = 0;
+    for (auto& ground : _grounds) {
+        b2Body* groundBody = getBody(ground.get());
+        assert(groundBody);
+        groundBody->SetTransform(b2Vec2(_GROUND_WIDTH_METERS + i * _GROUND_WIDTH_METERS,
+                _GROUND_OFFSET_METERS + 0.01f), 0.0f);
+        ++i;
+    }
+
+    // Put the bird back in its demo position. It may have been ragdolling since game over, so all
+    // of its motion needs to be stopped too.
+    _playableBirdBody->SetTransform(_BIRD_DEMO_POSITION, 0.0f);
+    _playableBirdBody->SetLinearVelocity(b2Vec2(0.0f, 0.0f));
+    _playableBirdBody->SetAngularVelocity(0.0f);
+    _playableBirdBody->SetAwake(true);
+
+    // populate the screen with the prepared NPEs, which are only allocated now if the preparation
+    // didn't get to finish during game over
+    prepareNextMap(true);
+    for (const NPE& npe : _nextMap.npes)
+        addNPE(npe);
+    _rightmostObstacleLocation = _nextMap.rightmost;
+    _nextMap.npes.clear();
+    _nextMap.rightmost = 0.0f;
+
+    // playable bird should be behind all other objects
+    _visibleActors.remove(&_playableBirdActor);
+    _visibleActors.push_front(&_playableBirdActor);
+}
+
+void GameLogic::prepareNextMap(const bool& finish) {
+
+    assert(_initialized);
+
+    while (_nextMap.rightmost < _SPAWN_LOCATION_X) {
+
+        // the map should start out with at least one NPC
+        makeStretch(_nextMapGenerator.next(!hasNPC(_nextMap), _BIRD_DEMO_POSITION.y),
+                b2Vec2(_nextMap.rightmost, _GROUND_OFFSET_METERS), _nextMap);
+
+        if (!finish)
+            break;
+    }
 }
 
 void GameLogic::removeOutOfBoundsActors() {
@@ -483,6 +693,14 @@ void GameLogic::removeOutOfBoundsActors() {
         bool isOutOfBounds = body->GetPosition().x < -10.0f &&
                 actor->getType() != PhysicalActor::TYPE::PLAYABLE_BIRD &&
                 actor->getType() != PhysicalActor::TYPE::GROUND;
+
+        // A frozen body drifts without falling, so one that's to the right of where everything
+        // spawns and isn't moving left, e.g. a rock thrown to the right, never comes back.
+        bool isFrozen = body->GetType() == b2_dynamicBody && !body->IsEnabled();
+        if (isFrozen && body->GetPosition().x > _SPAWN_LOCATION_X &&
+                body->GetLinearVelocity().x >= 0.0f)
+            isOutOfBounds = true;
+
         if (isOutOfBounds)
             OOBActors.push_back(actor);
     }
@@ -495,117 +713,176 @@ void GameLogic::removeOutOfBoundsActors() {
 
 void GameLogic::generateNewActors(const float& timeDelta) {
 
-    // something should be spawned if the rightmost obstalce location is to the left of the default
-    // spawn location
+    // Something should be spawned if the rightmost obstalce location is to the left of the default
+    // spawn location. It's only made right now if the planner hasn't already made it, and never
+    // when following a course file, which has to be spawned exactly as it is.
     bool needToSpawn = _rightmostObstacleLocation < _SPAWN_LOCATION_X;
-    if (needToSpawn)
+    if (needToSpawn && !spawnPlannedStretch() && !isFollowingCourseFile())
         spawnNPE(b2Vec2(_SPAWN_LOCATION_X, _GROUND_OFFSET_METERS));
     
     // update the rightmost obstacle location by decrementing it by amount the world has scrolled
     _rightmostObstacleLocation -= timeDelta * _worldScrollSpeed;
 }
 
-void GameLogic::spawnNPE(b2Vec2 position) {
+bool GameLogic::spawnPlannedStretch() {
 
-    //0: Streetlight
-    //1: Tree
-    //2: Cloud
-    //3: Lifeguard Tower
-    //4: Docks
-    //5: Umbrella
-    //6: NPC
-    int obstacleType = randomInt(0, 6);
-    
-    //if the same type of obstacle is chosen twice in a row, repoll the random number generator
-    while(obstacleType == _lastObstacleSpawned)
-        obstacleType = randomInt(0, 6);
+    // take the next stretch of the planned course, unless there isn't one yet, or unless it has no
+    // NPC while there's none on screen either, in which case one has to be spawned right away
+    Course stretch;
+    {
+        std::lock_guard<std::mutex> lock(_plannedCourseMutex);
+
+        if (_plannedCourse.empty() || (_NPCs.empty() && !hasNPC(_plannedCourse.front()) &&
+                !isFollowingCourseFile()))
+            return false;
+
+        stretch.npes.swap(_plannedCourse.front().npes);
+        stretch.rightmost = _plannedCourse.front().rightmost;
+        _plannedCourse.pop_front();
+        _plannedLength -= stretch.rightmost;
+    }
+
+    // the stretch was planned relative to the spawn location, only its bodies need to be made now
+    for (NPE& npe : stretch.npes) {
+        npe.position.x += _SPAWN_LOCATION_X;
+        addNPE(npe);
+    }
+    _rightmostObstacleLocation = _SPAWN_LOCATION_X + stretch.rightmost;
+
+    return true;
+}
+
+void GameLogic::planCourse() {
+
+    assert(_initialized);
+
+    // free whatever was planned for a previous state here rather than in toDemo() or toPlaying()
+    _discardedCourse.clear();
+
+    {
+        std::lock_guard<std::mutex> lock(_plannedCourseMutex);
+        if (_plannedLength >= _PLAN_AHEAD_METERS)
+            return;
+    }
+
+    // take the next stretch from the course file if there is one, otherwise generate it
+    CourseRecord record;
+    if (isFollowingCourseFile()) {
+        record = _courseFile->getRecord(_courseFileIndex);
+        _courseFileIndex = (_courseFileIndex + 1) % _courseFile->getNumRecords();
+    } else {
+        record = _plannerGenerator.next(false, _planForDemo ? _BIRD_DEMO_POSITION.y : -1.0f);
+    }
+
+    // make the stretch as though it's spawned at x = 0
+    Course stretch = {std::vector<NPE>(), 0.0f};
+    makeStretch(record, b2Vec2(0.0f, _GROUND_OFFSET_METERS), stretch);
+
+    std::lock_guard<std::mutex> lock(_plannedCourseMutex);
+    _plannedCourse.push_back(stretch);
+    _plannedLength += stretch.rightmost;
+}
+
+void GameLogic::discardPlannedCourse(const bool& forDemo) {
+
+    std::lock_guard<std::mutex> lock(_plannedCourseMutex);
+
+    // hand the stretches over to planCourse() to be freed, unless it hasn't freed the last ones yet
+    if (_discardedCourse.empty())
+        _discardedCourse.swap(_plannedCourse);
+    else
+        _plannedCourse.clear();
+
+    _plannedLength = 0.0f;
+    _planForDemo = forDemo;
+
+    // a course file is followed from its start every time
+    _courseFileIndex = 0;
+}
+
+bool GameLogic::isFollowingCourseFile() const {
+    return _courseFile && !_planForDemo;
+}
+
+bool GameLogic::hasNPC(const Course& course) {
+
+    for (const NPE& npe : course.npes) {
+        if (npe.npc)
+            return true;
+    }
+
+    return false;
+}
+
+void GameLogic::spawnNPE(b2Vec2 position) {
 
     // force the spawning of an NPC if there aren't any on screen
-    if (_NPCs.size() == 0)
-        obstacleType = 6;
-
-    float heightMeters = randomFloat(4.0f, (_state == DEMO ? 9.0f : 10.0f));
-    int numEntities = _obstacles.size() + _NPCs.size(); //used for checking whether an obstacle was actually generated or not
-    bool faceLeft = randomBool();
-
-    switch(obstacleType) {
-        case 0:
-            {
-                if(_lastObstacleSpawned != 1) { //don't spawn streetlights directly after trees
-                    position.x += (faceLeft ? 2.7f : 1.0f);
-                    _obstacles.push_back(ObstacleFactory::makeStreetlight(heightMeters, faceLeft));
-                    addToWorld(*_obstacles.back(), position);
-                    _rightmostObstacleLocation = position.x + (faceLeft ? 1.0f : 2.7f);
-                }
-                break;
-            }
-        case 1:
-            position.x += (faceLeft ? 1.44f + heightMeters * 0.65f : 2.5f);
-            _obstacles.push_back(ObstacleFactory::makeTree(heightMeters, faceLeft));
-            addToWorld(*_obstacles.back(), position);
-            _rightmostObstacleLocation = position.x + (faceLeft ? 2.5f : 1.44f + heightMeters * 0.65f);
+    CourseRecord record = _courseGenerator.next(_NPCs.empty(),
+            _state == DEMO ? _BIRD_DEMO_POSITION.y : -1.0f);
+
+    Course course = {std::vector<NPE>(), 0.0f};
+    makeStretch(record, position, course);
+    for (const NPE& npe : course.npes)
+        addNPE(npe);
+    _rightmostObstacleLocation = course.rightmost;
+}
+
+void GameLogic::makeStretch(const CourseRecord& record, const b2Vec2& start, Course& course) {
+
+    b2Vec2 position(start.x + record.offset, start.y);
+    bool faceLeft = record.faceLeft;
+
+    switch (record.kind) {
+        case CourseRecord::STREETLIGHT:
+            course.npes.push_back({ObstacleFactory::makeStreetlight(record.values[0], faceLeft),
+                    nullptr, position});
+            break;
+        case CourseRecord::TREE:
+            course.npes.push_back({ObstacleFactory::makeTree(record.values[0], faceLeft), nullptr,
+                    position});
+            break;
+        case CourseRecord::CLOUD:
+            course.npes.push_back({ObstacleFactory::makeCloud(), nullptr,
+                    b2Vec2(position.x, record.values[0])});
+            break;
+        case CourseRecord::LIFEGUARD:
+            course.npes.push_back({ObstacleFactory::makeLifeguard(faceLeft), nullptr, position});
+            break;
+        case CourseRecord::DOCKS:
+            course.npes.push_back({ObstacleFactory::makeDocks(record.values[0], record.values[1]),
+                    nullptr, position});
             break;
-        case 2:
-            {
-                float height = randomFloat(6.0f, 12.0f);
-                if (_state == DEMO)
-                    height = randomBool() ? randomFloat(6.0f, _BIRD_DEMO_POSITION.y - 1.1f) :
-                            randomFloat(_BIRD_DEMO_POSITION.y + 1.1f, 12.0f);
-                position.x += 1.0f;
-                _obstacles.push_back(ObstacleFactory::makeCloud());
-                addToWorld(*_obstacles.back(), b2Vec2(position.x, height));
-                _rightmostObstacleLocation = position.x + 1.0f;
-                break;
-            }
-        case 3:
-            position.x += 2.3f;
-            _obstacles.push_back(ObstacleFactory::makeLifeguard(faceLeft));
-            addToWorld(*_obstacles.back(), position);
-            _rightmostObstacleLocation = position.x + 2.3f;
+        case CourseRecord::UMBRELLA:
+            course.npes.push_back({ObstacleFactory::makeUmbrella(record.values[0]), nullptr,
+                    position - b2Vec2(0.0f, 0.02f)});
             break;
-        case 4:
-            {
-                int width = randomInt(2, 5);
-                int height = randomInt(1, 5);
-                position.x -= 0.8f;
-                _obstacles.push_back(ObstacleFactory::makeDocks(width, height));
-                addToWorld(*_obstacles.back(), position);
-                _rightmostObstacleLocation = position.x + 1.0f + width * 1.9f;
-                bool spawnNPC = randomBool();
-                if(spawnNPC) {
-                    _NPCs.push_back(randomBool() ? NPCFactory::makeMale() : NPCFactory::makeFemale());
-                    // NPCs should get drawn behind everything
-                    addToWorld(*_NPCs.back(), b2Vec2(position.x+randomFloat(2.0f, 2.0f+width), height), true, false);
-                }
-                break;
-            }
-        case 5:
-            {
-                float angle = randomFloat(-PI/4.0f, PI / 4.0f);
-                position.x += 1.5f;
-                _obstacles.push_back(ObstacleFactory::makeUmbrella(angle));
-                addToWorld(*_obstacles.back(), position - b2Vec2(0.0f, 0.02f));
-                _rightmostObstacleLocation = position.x + 1.5f;
-                break;
-            }
-        case 6:
-            position.x += randomFloat(1.0f, 3.0f); // give the NPC some room to move around
-            _NPCs.push_back(randomBool() ? NPCFactory::makeMale() : NPCFactory::makeFemale());
-            // NPCs should get drawn behind everything
-            addToWorld(*_NPCs.back(), position, true, false);
-            _rightmostObstacleLocation = position.x + 1.0f;
+        case CourseRecord::LONE_NPC:
             break;
     }
 
-    // give the next obstacle some breathing room
-    bool somethingWasSpawned = numEntities != _obstacles.size() + _NPCs.size();
-    if (somethingWasSpawned)
-        _rightmostObstacleLocation += randomFloat(0.0f, 4.0f);
-        
-    // set the type of the last obstacle spawned, but don't worry about it if it was an NPC
-    bool nonNPCWasSpawned = somethingWasSpawned && obstacleType != 6;
-    if (nonNPCWasSpawned)
-        _lastObstacleSpawned = obstacleType;
+    // an NPC either stands on top of the docks or on its own
+    if (record.npc != CourseRecord::NO_NPC) {
+        b2Vec2 npcPosition = record.kind == CourseRecord::DOCKS ?
+                b2Vec2(start.x + record.values[2], record.values[1]) : position;
+        course.npes.push_back({nullptr, record.npc == CourseRecord::MALE ?
+                NPCFactory::makeMale() : NPCFactory::makeFemale(), npcPosition});
+    }
+
+    course.rightmost = start.x + record.length;
+}
+
+void GameLogic::addNPE(const NPE& npe) {
+
+    if (npe.npc) {
+        _NPCs.push_back(npe.npc);
+        // NPCs should get drawn behind everything, and they only start acting once they're added
+        addToWorld(*npe.npc, npe.position, true, false);
+        npe.npc->setTimerWheel(&_timers);
+    } else {
+        assert(npe.obstacle);
+        _obstacles.push_back(npe.obstacle);
+        addToWorld(*npe.obstacle, npe.position);
+    }
 }
 
 b2Body* GameLogic::addToWorld(const PhysicalActor& actor, const b2Vec2& position,
@@ -666,6 +943,10 @@ void GameLogic::removeFromWorld(const PhysicalActor& actor) {
 
     // remove entry from the _physicalActors map
     _physicalActors.erase(actorAddress);
+
+    // an NPC's timers refer to it, so they have to go before it does
+    if (actor.getType() == PhysicalActor::TYPE::NPC)
+        ((NPC&)actor).setTimerWheel(nullptr);
     
     // Actors in lists are dynamically allocated, so need to remove them from the list and free the
     // associated memory. Just attempt to remove the actor from all the actor lists.
@@ -677,12 +958,78 @@ void GameLogic::removeFromWorld(const PhysicalActor& actor) {
 }
 
 void GameLogic::removeAllFromWorld() {
-    while (true) {
-        auto i = _physicalActors.begin();
-        if (i == _physicalActors.end())
-            return;
-        removeFromWorld(*i->first);
+
+    // Destroy every body and detach the NPCs from the timer wheel, then let go of every actor at
+    // once. Whatever is still pending, e.g. the bird's poop timers, is cancelled as well, since
+    // nothing is left for it to act on.
+    for (auto& pair : _physicalActors)
+        _world->DestroyBody(pair.second);
+    for (auto& npc : _NPCs)
+        npc->setTimerWheel(nullptr);
+    _timers.clear();
+    _physicalActors.clear();
+    _visibleActors.clear();
+    _grounds.clear();
+    _obstacles.clear();
+    _NPCs.clear();
+    _projectiles.clear();
+    _playableBirdBody = nullptr;
+}
+
+void GameLogic::removeSpawnedFromWorld() {
+
+    assert(_initialized);
+
+    // destroy the bodies of everything that isn't kept, and forget about them
+    for (auto i = _physicalActors.begin(); i != _physicalActors.end();) {
+        const PhysicalActor* actor = i->first;
+        bool isKept = actor->getType() == PhysicalActor::TYPE::PLAYABLE_BIRD ||
+                actor->getType() == PhysicalActor::TYPE::GROUND;
+        if (isKept) {
+            ++i;
+        } else {
+            _world->DestroyBody(i->second);
+            i = _physicalActors.erase(i);
+        }
     }
+
+    // only the kept actors are still visible, and the rest of the actors can be freed once the
+    // NPCs' timers are cancelled
+    _visibleActors.remove_if([this](PhysicalActor* actor) {
+        return _physicalActors.find(actor) == _physicalActors.end();
+    });
+    for (auto& npc : _NPCs)
+        npc->setTimerWheel(nullptr);
+    _obstacles.clear();
+    _NPCs.clear();
+    _projectiles.clear();
+}
+
+void GameLogic::stepWorld(const float& timeDelta) {
+
+    assert(_initialized);
+
+    _timers.advance(timeDelta);
+    updatePlayableBird(timeDelta);
+    _world->Step(timeDelta, 8, 4);
+}
+
+void GameLogic::restartPoopTimers() {
+
+    assert(_initialized);
+
+    _lastPoopTime = _timers.getTime();
+
+    // the bird stops pooping after a bit, and dies if it doesn't poop again for a while
+    _timers.cancel(_poopTimer);
+    _poopTimer = _timers.schedule(_BIRD_POOP_DURATION, [this]() {
+        _playableBirdActor.stopPooping();
+    });
+    _timers.cancel(_deathTimer);
+    _deathTimer = _timers.schedule(_BIRD_DEATH_TIME, [this]() {
+        if (_state == PLAYING)
+            queueGameOver();
+    });
 }
 
 void GameLogic::updatePlayableBird(const float& timeDelta) {
@@ -692,16 +1039,6 @@ void GameLogic::updatePlayableBird(const float& timeDelta) {
     // make sure the bird's body isn't nullptr
     assert(_playableBirdBody);
 
-    // update bird pooping status
-    _timeSinceLastPoop += timeDelta;
-    if (_timeSinceLastPoop >= _BIRD_POOP_DURATION)
-        _playableBirdActor.stopPooping();
-
-    // kill the bird if it hasn't pooped for a while
-    if (_timeSinceLastPoop >= _BIRD_DEATH_TIME && _state == PLAYING) {
-        eventMessenger.triggerEvent(GameOverEvent());
-    }
-    
     // if the bird is flying and state is PLAYING, then apply an upward force opposite to gravity
     if (_playableBirdActor.isFlying() && _state == PLAYING) {
         float targetAccel = -2.0f * _GRAVITY.y;
@@ -734,9 +1071,6 @@ void GameLogic::updatePlayableBird(const float& timeDelta) {
             _playableBirdBody->SetTransform(b2Vec2(position.x, _BIRD_MAX_HEIGHT),
                     _playableBirdBody->GetAngle());
     }
-
-    // call bird's own update() method
-    _playableBirdActor.update(timeDelta);
 }
 
 void GameLogic::updateNPCs(const float& timeDelta) {
@@ -749,8 +1083,7 @@ void GameLogic::updateNPCs(const float& timeDelta) {
         assert(npcBody);
 
         // set whether the NPC is on the screen or not
-        float xPos = npcBody->GetPosition().x;
-        npc->isVisible = xPos >= -0.0f && xPos <= NATIVE_RESOLUTION.x * METERS_PER_PIXEL;
+        npc->isVisible = isOnScreen(npcBody, 0.0f);
 
         // if the npc is walking, then move it in the direction it's facing
         if (npc->isWalking()) {
@@ -760,14 +1093,56 @@ void GameLogic::updateNPCs(const float& timeDelta) {
 
         // if the npc is throwing, then make it always face the bird
         } else if (npc->isThrowing()) {
-            bool shouldFaceLeft = _playableBirdBody->GetPosition().x < npcBody->GetPosition().x;
-            npc->setFacingLeft(shouldFaceLeft);
+            npc->setFacingLeft(getOffsetToBird(*npc).x < 0.0f);
         }
+    }
+}
+
+void GameLogic::updateOffscreenActors(const float& timeDelta) {
+
+    assert(_initialized);
+
+    for (auto& pair : _physicalActors) {
 
-        npc->update(timeDelta);
+        PhysicalActor* actor = pair.first;
+        b2Body* body = pair.second;
+
+        // the bird and the ground don't have a policy, they're always updated
+        auto policy = _offscreenPolicies.find(actor->getType());
+        if (policy == _offscreenPolicies.end())
+            continue;
+        bool isReduced = policy->second != OFFSCREEN_POLICY::FULL && !isOnScreen(body);
+        bool isFrozen = isReduced && policy->second == OFFSCREEN_POLICY::FROZEN &&
+                body->GetType() == b2_dynamicBody;
+
+        // NPCs only animate on the screen, and pick up where they would be once they're back
+        bool isNPC = actor->getType() == PhysicalActor::TYPE::NPC;
+        if (isNPC)
+            ((NPC*)actor)->setAnimated(!isReduced);
+
+        // Frozen bodies leave the simulation, so they don't collide or fall, but they still drift
+        // at the velocity they had so that they're where they should be once they're unfrozen.
+        // Bodies which aren't dynamic are moved by the world for next to nothing anyway.
+        if (body->GetType() == b2_dynamicBody && body->IsEnabled() == isFrozen)
+            body->SetEnabled(!isFrozen);
+        if (isFrozen) {
+            body->SetTransform(body->GetPosition() + timeDelta * body->GetLinearVelocity(),
+                    body->GetAngle());
+        }
+
+        // only count the updates that actually had something skipped
+        UpdateStats& stats = _updateStats[actor->getType()];
+        ++stats.numUpdates;
+        if ((isNPC && isReduced) || isFrozen)
+            ++stats.numSkipped;
     }
 }
 
+bool GameLogic::isOnScreen(const b2Body* body, const float& margin) const {
+    float xPos = body->GetPosition().x;
+    return xPos >= -margin && xPos <= NATIVE_RESOLUTION.x * METERS_PER_PIXEL + margin;
+}
+
 void GameLogic::updateGround() {
 
     assert(_initialized);
@@ -141,21 +141,21 @@ void GameOverActivity::update(const float& timeDelta) {
         _animationTimer += timeDelta;
 }
 
-void GameOverActivity::draw(sf::RenderTarget& target) {
+void GameOverActivity::draw(RenderSnapshot& snapshot) {
 
     assert(_initialized);
     assert(_activated);
 
     // draw red screen
-    target.draw(_redScreen);
+    snapshot.add(_redScreen);
 
     // draw texts
     for (sf::Text* text : _texts)
-        target.draw(*text);
+        snapshot.add(*text);
 
     // draw buttons
     for (Button* button : _buttons)
-        target.draw(*button);
+        button->draw(snapshot);
 }
 
 void GameOverActivity::buttonClickHandler(const Event& event) {
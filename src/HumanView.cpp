@@ -41,10 +41,9 @@ void HumanView::init(GameLogic& logic) {
     _logic = &logic;
         
     // set the beach background sprite and scale it according to the beach background resource
-    const SpriteResource* beachSpriteResource =
-            resourceCache.getResource<SpriteResource>("BEACH_BACKGROUND_SPRITE");
-    _beachBackground = beachSpriteResource->sprite;
-    _beachBackground.scale(beachSpriteResource->scaleFactor, beachSpriteResource->scaleFactor);
+    _beachSpriteResource = resourceCache.acquire<SpriteResource>("BEACH_BACKGROUND_SPRITE");
+    _beachBackground = _beachSpriteResource->sprite;
+    _beachBackground.scale(_beachSpriteResource->scaleFactor, _beachSpriteResource->scaleFactor);
 
     // initialize and add event listeners
     _keyPressListener.init(&HumanView::keyPressHandler, this);
@@ -58,12 +57,11 @@ void HumanView::update(const float& timeDelta) {
     assert(_initialized);
 }
 
-void HumanView::draw(sf::RenderTarget& target, sf::RenderStates states) const {
+void HumanView::draw(RenderSnapshot& snapshot) const {
 
     assert(_initialized);
 
-    // draw beach background
-    target.draw(_beachBackground);
+    drawBackground(snapshot);
 
     // draw all visible actors given by the logic
     for (PhysicalActor* actor : _logic->getVisibleActors()) {
@@ -74,19 +72,27 @@ void HumanView::draw(sf::RenderTarget& target, sf::RenderStates states) const {
 
         // Set a transform to draw the actor in the correct position and rotation graphically. This
         // assumes that the actor is at graphical position (0, 0).
-        sf::RenderStates statesCopy = states;
-        statesCopy.transform *= physicalToGraphicalTransform(*body);
-        target.draw(*actor, statesCopy);
+        sf::RenderStates states;
+        states.transform = physicalToGraphicalTransform(*body);
+        actor->draw(snapshot, states);
     }
 }
 
+void HumanView::drawBackground(RenderSnapshot& snapshot) const {
+
+    assert(_initialized);
+
+    // draw beach background
+    snapshot.add(_beachBackground);
+}
+
 void HumanView::keyPressHandler(const Event& event) {
     assert(event.getType() == KeyPressEvent::TYPE);
 
     const KeyPressEvent& e = dynamic_cast<const KeyPressEvent&>(event);
 
     if (e.key == _keyToPoop)
-        _logic->requestBirdPoop();
+        _logic->requestBirdPoop(e.age);
     
     else if (e.key == _keyToPause)
         eventMessenger.queueEvent(GamePauseEvent(_logic->isPaused() ?
@@ -94,7 +100,7 @@ void HumanView::keyPressHandler(const Event& event) {
     
     // all keys besides those cause the bird to start flying
     else
-        _logic->requestBirdStartFly();
+        _logic->requestBirdStartFly(e.age);
 }
 
 void HumanView::keyReleaseHandler(const Event& event) {
@@ -103,5 +109,5 @@ void HumanView::keyReleaseHandler(const Event& event) {
     const KeyReleaseEvent& e = dynamic_cast<const KeyReleaseEvent&>(event);
 
     if(e.key != _keyToPoop && e.key != _keyToPause)
-        _logic->requestBirdStopFly();
+        _logic->requestBirdStopFly(e.age);
 }
\ No newline at end of file
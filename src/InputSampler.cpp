@@ -0,0 +1,127 @@
+#include <cassert>
+#include <algorithm>
+#include <vector>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#include <SFML/Window.hpp>
+
+#include "InputSampler.hpp"
+
+InputSampler::InputSampler() :
+    _running(false),
+    _paused(false),
+    _PERIOD(1000),
+    _MAX_AGE(1000)
+{}
+
+InputSampler::~InputSampler() {
+    stop();
+}
+
+void InputSampler::start(const std::vector<sf::Keyboard::Key>& keys) {
+
+    assert(!_thread.joinable());
+
+    _keys = keys;
+    _transitions.clear();
+    _paused = false;
+    _running = true;
+    _thread = std::thread(&InputSampler::sampleLoop, this);
+}
+
+void InputSampler::stop() {
+
+    if (!_thread.joinable())
+        return;
+
+    // wake the thread up in case it's paused
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _running = false;
+    }
+    _resumed.notify_one();
+    _thread.join();
+}
+
+void InputSampler::setPaused(const bool& paused) {
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _paused = paused;
+    }
+    _resumed.notify_one();
+}
+
+InputSampler::Clock::time_point InputSampler::takeTime(const sf::Keyboard::Key& key,
+        const bool& pressed, const Clock::time_point& fallback, bool& wasSampled) {
+
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    // find the oldest matching transition that isn't too old to belong to this event
+    Clock::time_point oldest = Clock::now() - _MAX_AGE;
+    auto match = std::find_if(_transitions.begin(), _transitions.end(),
+            [&](const Transition& transition) {
+                return transition.key == key && transition.pressed == pressed &&
+                        transition.time >= oldest;
+            });
+
+    wasSampled = match != _transitions.end();
+    if (!wasSampled)
+        return fallback;
+    Clock::time_point time = match->time;
+
+    // forget it, and whatever happened to the key or is too old before it
+    ++match;
+    auto end = std::remove_if(_transitions.begin(), match, [&](const Transition& transition) {
+        return transition.key == key || transition.time < oldest;
+    });
+    _transitions.erase(end, match);
+
+    return time;
+}
+
+void InputSampler::sampleLoop() {
+
+    std::vector<bool> wasPressed(_keys.size(), false);
+    for (std::size_t i = 0; i < _keys.size(); ++i)
+        wasPressed[i] = sf::Keyboard::isKeyPressed(_keys[i]);
+
+    while (_running) {
+
+        std::this_thread::sleep_for(_PERIOD);
+
+        // While paused, sleep until resumed. The keys may have changed in the meantime, but not
+        // when they're seen changing, so start over from their current state instead of timing
+        // those changes.
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            if (_paused) {
+                _resumed.wait(lock, [this]() { return !_paused || !_running; });
+                lock.unlock();
+                for (std::size_t i = 0; i < _keys.size(); ++i)
+                    wasPressed[i] = sf::Keyboard::isKeyPressed(_keys[i]);
+                continue;
+            }
+        }
+
+        // remember the keys which changed since the last sample
+        for (std::size_t i = 0; i < _keys.size(); ++i) {
+            bool isPressed = sf::Keyboard::isKeyPressed(_keys[i]);
+            if (isPressed == wasPressed[i])
+                continue;
+            wasPressed[i] = isPressed;
+
+            // also forget the transitions which were never taken, e.g. because they were too fast
+            // for the window to see
+            Transition transition = {_keys[i], isPressed, Clock::now()};
+            std::lock_guard<std::mutex> lock(_mutex);
+            auto end = std::find_if(_transitions.begin(), _transitions.end(),
+                    [&](const Transition& old) { return old.time >= transition.time - _MAX_AGE; });
+            _transitions.erase(_transitions.begin(), end);
+            _transitions.push_back(transition);
+        }
+    }
+}
@@ -0,0 +1,279 @@
+#include <cassert>
+#include <algorithm>
+#include <functional>
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <utility>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#include "JobSystem.hpp"
+
+namespace {
+
+// index of the queue of the thread that's running this code; the thread calling run() uses 0
+thread_local int currentQueue = 0;
+
+}
+
+JobSystem::JobSystem(unsigned numThreads) :
+    _running(false),
+    _numUnfinished(0),
+    _numQueued(0),
+    _stopping(false),
+    _numRuns(0)
+{
+    // the thread calling run() takes one hardware thread
+    if (numThreads == 0) {
+        unsigned hardwareThreads = std::thread::hardware_concurrency();
+        numThreads = hardwareThreads > 1 ? hardwareThreads - 1 : 0;
+    }
+
+    for (unsigned i = 0; i <= numThreads; ++i)
+        _queues.push_back(std::unique_ptr<Queue>(new Queue()));
+    for (unsigned i = 1; i <= numThreads; ++i)
+        _threads.push_back(std::thread(&JobSystem::workerLoop, this, i));
+}
+
+JobSystem::~JobSystem() {
+
+    assert(!_running);
+
+    {
+        std::lock_guard<std::mutex> lock(_wakeMutex);
+        _stopping = true;
+    }
+    _wakeCondition.notify_all();
+
+    for (std::thread& thread : _threads)
+        thread.join();
+}
+
+int JobSystem::add(const std::string& name, const std::function<void()>& function,
+        const std::vector<int>& dependencies) {
+
+    return addJob(name, function, dependencies, false);
+}
+
+int JobSystem::addOnCaller(const std::string& name, const std::function<void()>& function,
+        const std::vector<int>& dependencies) {
+
+    return addJob(name, function, dependencies, true);
+}
+
+int JobSystem::addJob(const std::string& name, const std::function<void()>& function,
+        const std::vector<int>& dependencies, const bool& onCaller) {
+
+    int id;
+    bool isReady;
+    {
+        std::lock_guard<std::mutex> lock(_graphMutex);
+
+        id = _jobs.size();
+        _jobs.push_back(Job());
+        Job& job = _jobs.back();
+        job.name = name;
+        job.function = function;
+        job.numWaiting = 0;
+        job.onCaller = onCaller;
+        job.finished = false;
+        job.time = 0.0;
+
+        // only wait on the dependencies which haven't finished already
+        for (int dependency : dependencies) {
+            assert(dependency >= 0 && dependency < id);
+            Job& dependencyJob = _jobs[dependency];
+            if (!dependencyJob.finished) {
+                dependencyJob.dependents.push_back(id);
+                ++job.numWaiting;
+            }
+        }
+
+        ++_numUnfinished;
+
+        // jobs which are ready before run() is called wait for it
+        isReady = job.numWaiting == 0;
+        if (isReady && !_running) {
+            _readyJobs.push_back(id);
+            isReady = false;
+        }
+    }
+
+    if (isReady)
+        push(currentQueue, id, onCaller);
+
+    return id;
+}
+
+void JobSystem::run() {
+
+    std::vector<std::pair<int, bool>> readyJobs;
+    {
+        std::lock_guard<std::mutex> lock(_graphMutex);
+        assert(!_running);
+        _running = true;
+        for (int job : _readyJobs)
+            readyJobs.push_back(std::make_pair(job, _jobs[job].onCaller));
+        _readyJobs.clear();
+    }
+    for (auto& job : readyJobs)
+        push(0, job.first, job.second);
+
+    // help running jobs until all of them have finished, including those added along the way
+    while (_numUnfinished > 0) {
+        if (!runOne(0))
+            std::this_thread::yield();
+    }
+
+    // record the timings and forget the jobs
+    std::lock_guard<std::mutex> lock(_graphMutex);
+    _running = false;
+    ++_numRuns;
+    for (auto& pair : _stats)
+        pair.second.lastTime = 0.0;
+    for (const Job& job : _jobs) {
+        JobStats& stats = _stats[job.name];
+        ++stats.numRuns;
+        stats.totalTime += job.time;
+        stats.maxTime = std::max(stats.maxTime, job.time);
+        stats.lastTime += job.time;
+    }
+    _jobs.clear();
+}
+
+void JobSystem::printStats(std::ostream& out) const {
+
+    std::ios::fmtflags flags = out.flags();
+    std::streamsize precision = out.precision();
+
+    out << "job statistics over " << _numRuns << " runs on " << getNumThreads() << " threads"
+            << std::endl;
+    out << std::left << std::setw(20) << "job" << std::right
+            << std::setw(12) << "runs"
+            << std::setw(12) << "total ms"
+            << std::setw(12) << "max ms"
+            << std::setw(12) << "last ms" << std::endl;
+
+    for (auto& pair : _stats) {
+        const JobStats& stats = pair.second;
+        out << std::left << std::setw(20) << pair.first << std::right
+                << std::setw(12) << stats.numRuns
+                << std::setw(12) << std::fixed << std::setprecision(3)
+                << stats.totalTime * 1000.0
+                << std::setw(12) << stats.maxTime * 1000.0
+                << std::setw(12) << stats.lastTime * 1000.0 << std::endl;
+    }
+
+    out.flags(flags);
+    out.precision(precision);
+}
+
+void JobSystem::workerLoop(const int& queueIndex) {
+
+    currentQueue = queueIndex;
+
+    while (true) {
+
+        if (runOne(queueIndex))
+            continue;
+
+        // sleep until something is queued, or the job system stops
+        std::unique_lock<std::mutex> lock(_wakeMutex);
+        _wakeCondition.wait(lock, [this]() { return _stopping || _numQueued > 0; });
+        if (_stopping)
+            return;
+    }
+}
+
+bool JobSystem::runOne(const int& queueIndex) {
+
+    // the jobs which only this thread may run come first, oldest first
+    int jobIndex = -1;
+    bool isOnCaller = false;
+    if (queueIndex == 0) {
+        std::lock_guard<std::mutex> lock(_callerQueue.mutex);
+        if (!_callerQueue.jobs.empty()) {
+            jobIndex = _callerQueue.jobs.front();
+            _callerQueue.jobs.pop_front();
+            isOnCaller = true;
+        }
+    }
+
+    // then the newest job from this thread's queue
+    if (jobIndex < 0) {
+        Queue& queue = *_queues[queueIndex];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (!queue.jobs.empty()) {
+            jobIndex = queue.jobs.back();
+            queue.jobs.pop_back();
+        }
+    }
+
+    // otherwise steal the oldest job from another thread's queue
+    for (unsigned i = 1; jobIndex < 0 && i < _queues.size(); ++i) {
+        Queue& queue = *_queues[(queueIndex + i) % _queues.size()];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (!queue.jobs.empty()) {
+            jobIndex = queue.jobs.front();
+            queue.jobs.pop_front();
+        }
+    }
+
+    if (jobIndex < 0)
+        return false;
+    if (!isOnCaller)
+        --_numQueued;
+
+    Job* job;
+    {
+        std::lock_guard<std::mutex> lock(_graphMutex);
+        job = &_jobs[jobIndex];
+    }
+
+    typedef std::chrono::steady_clock Clock;
+    Clock::time_point start = Clock::now();
+    job->function();
+    double time = std::chrono::duration<double>(Clock::now() - start).count();
+
+    // finish the job, and queue the dependents that aren't waiting on anything else anymore
+    std::vector<std::pair<int, bool>> readyJobs;
+    {
+        std::lock_guard<std::mutex> lock(_graphMutex);
+        job->finished = true;
+        job->time = time;
+        for (int dependent : job->dependents) {
+            Job& dependentJob = _jobs[dependent];
+            if (--dependentJob.numWaiting == 0)
+                readyJobs.push_back(std::make_pair(dependent, dependentJob.onCaller));
+        }
+    }
+    for (auto& dependent : readyJobs)
+        push(queueIndex, dependent.first, dependent.second);
+
+    --_numUnfinished;
+    return true;
+}
+
+void JobSystem::push(const int& queueIndex, const int& job, const bool& onCaller) {
+
+    if (onCaller) {
+        std::lock_guard<std::mutex> lock(_callerQueue.mutex);
+        _callerQueue.jobs.push_back(job);
+        return;
+    }
+
+    ++_numQueued;
+    {
+        Queue& queue = *_queues[queueIndex];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.jobs.push_back(job);
+    }
+
+    // lock the wake mutex so that a thread which is about to sleep doesn't miss this
+    {
+        std::lock_guard<std::mutex> lock(_wakeMutex);
+    }
+    _wakeCondition.notify_all();
+}
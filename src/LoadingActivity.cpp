@@ -0,0 +1,55 @@
+#include <cassert>
+
+#include <SFML/Graphics.hpp>
+
+#include "LoadingActivity.hpp"
+#include "Globals.hpp"
+
+LoadingActivity::LoadingActivity() :
+    _initialized(false),
+    _PROGRESS_BAR_SIZE(400.0f, 20.0f),
+    _SPIN_SPEED(270.0f)
+{}
+
+void LoadingActivity::init() {
+
+    _initialized = true;
+
+    sf::Vector2f center(NATIVE_RESOLUTION.x / 2.0f, NATIVE_RESOLUTION.y / 2.0f);
+
+    // set up the progress bar, origin on the left edge
+    _progressOutline.setSize(_PROGRESS_BAR_SIZE);
+    _progressOutline.setOrigin(0.0f, _PROGRESS_BAR_SIZE.y / 2.0f);
+    _progressOutline.setPosition(center.x - _PROGRESS_BAR_SIZE.x / 2.0f, center.y + 50.0f);
+    _progressOutline.setFillColor(sf::Color::Transparent);
+    _progressOutline.setOutlineColor(sf::Color::White);
+    _progressOutline.setOutlineThickness(2.0f);
+    _progressBar.setSize(sf::Vector2f(0.0f, _PROGRESS_BAR_SIZE.y));
+    _progressBar.setOrigin(_progressOutline.getOrigin());
+    _progressBar.setPosition(_progressOutline.getPosition());
+    _progressBar.setFillColor(sf::Color::White);
+
+    // set up the spinner, origin in the center
+    _spinner.setSize(sf::Vector2f(30.0f, 30.0f));
+    _spinner.setOrigin(15.0f, 15.0f);
+    _spinner.setPosition(center.x, center.y - 20.0f);
+    _spinner.setFillColor(sf::Color::White);
+}
+
+void LoadingActivity::update(const float& timeDelta) {
+
+    assert(_initialized);
+
+    _progressBar.setSize(sf::Vector2f(_PROGRESS_BAR_SIZE.x * resourceCache.getLoadingProgress(),
+            _PROGRESS_BAR_SIZE.y));
+    _spinner.rotate(_SPIN_SPEED * timeDelta);
+}
+
+void LoadingActivity::draw(RenderSnapshot& snapshot) {
+
+    assert(_initialized);
+
+    snapshot.add(_progressOutline);
+    snapshot.add(_progressBar);
+    snapshot.add(_spinner);
+}
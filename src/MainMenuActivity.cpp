@@ -43,8 +43,8 @@ void MainMenuActivity::init(PlayingActivity& playingActivity) {
     _playingActivity = &playingActivity;
 
     // set up the logo
-    const SpriteResource& logoSprite =
-            *resourceCache.getResource<SpriteResource>("TITLE_LOGO_SPRITE");
+    _logoSpriteResource = resourceCache.acquire<SpriteResource>("TITLE_LOGO_SPRITE");
+    const SpriteResource& logoSprite = *_logoSpriteResource;
     _logo = logoSprite.sprite;
     _logo.scale(logoSprite.scaleFactor, logoSprite.scaleFactor);
     _logo.setPosition(200.0f, 160.0f);
@@ -91,16 +91,16 @@ void MainMenuActivity::update(const float& timeDelta) {
     assert(_activated);
 }
 
-void MainMenuActivity::draw(sf::RenderTarget& target) {
+void MainMenuActivity::draw(RenderSnapshot& snapshot) {
 
     assert(_initialized);
     assert(_activated);
 
-    target.draw(_logo);
+    snapshot.add(_logo);
 
     // draw all buttons
     for (Button* button : _buttons)
-        target.draw(*button);
+        button->draw(snapshot);
 }
 
 void MainMenuActivity::buttonClickHandler(const Event& event) {
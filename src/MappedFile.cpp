@@ -0,0 +1,117 @@
+#include <cstddef>
+#include <string>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+#include "MappedFile.hpp"
+
+MappedFile::MappedFile() :
+    _data(nullptr),
+    _size(0),
+    _fileHandle(nullptr),
+    _mappingHandle(nullptr)
+{}
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+#ifdef _WIN32
+
+bool MappedFile::open(const std::string& filename) {
+
+    close();
+
+    HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+            OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        return false;
+
+    // empty files can't be mapped
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+        CloseHandle(file);
+        return false;
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping == nullptr) {
+        CloseHandle(file);
+        return false;
+    }
+
+    void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (data == nullptr) {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+
+    _data = (const unsigned char*)data;
+    _size = (std::size_t)size.QuadPart;
+    _fileHandle = file;
+    _mappingHandle = mapping;
+    return true;
+}
+
+void MappedFile::close() {
+
+    if (_data != nullptr)
+        UnmapViewOfFile(_data);
+    if (_mappingHandle != nullptr)
+        CloseHandle(_mappingHandle);
+    if (_fileHandle != nullptr)
+        CloseHandle(_fileHandle);
+
+    _data = nullptr;
+    _size = 0;
+    _fileHandle = nullptr;
+    _mappingHandle = nullptr;
+}
+
+#else
+
+bool MappedFile::open(const std::string& filename) {
+
+    close();
+
+    int file = ::open(filename.c_str(), O_RDONLY);
+    if (file < 0)
+        return false;
+
+    // empty files can't be mapped
+    struct stat info;
+    if (fstat(file, &info) != 0 || info.st_size == 0) {
+        ::close(file);
+        return false;
+    }
+
+    void* data = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+
+    // the mapping stays valid after the file descriptor is closed
+    ::close(file);
+    if (data == MAP_FAILED)
+        return false;
+
+    _data = (const unsigned char*)data;
+    _size = (std::size_t)info.st_size;
+    return true;
+}
+
+void MappedFile::close() {
+
+    if (_data != nullptr)
+        munmap((void*)_data, _size);
+
+    _data = nullptr;
+    _size = 0;
+}
+
+#endif
@@ -1,5 +1,6 @@
 #include <cassert>
 #include <iostream>
+#include <algorithm>
 
 #include <SFML/Graphics.hpp>
 #include <box2d/box2d.h>
@@ -9,6 +10,7 @@
 #include "Globals.hpp"
 #include "Utils.hpp"
 #include "GameLogic.hpp"
+#include "TimerWheel.hpp"
 #include "Resources/SpriteResource.hpp"
 #include "Resources/PolygonResource.hpp"
 
@@ -39,24 +41,26 @@ NPC::NPC(const NPC::TYPE& type) :
     _startFrame(0),
     _numFrames(1),
     _currentFrame(0),
-    _frameTimer(0.0f),
+    _firstFrame(0),
+    _animationStartTime(0.0),
+    _isAnimated(true),
 
     _isFacingLeft(false),
     _isReadyToFinishThrowing(false),
-    _actionTimeRemaining(0.0f),
-    _prepareTimeRemaining(0.0f),
     _nextAction(ACTION::IDLE),
-    _nextActionDuration(0.0f)
+    _nextActionDuration(0.0f),
+
+    _timers(nullptr),
+    _frameTimer(TimerWheel::NO_TIMER),
+    _actionTimer(TimerWheel::NO_TIMER),
+    _prepareTimer(TimerWheel::NO_TIMER)
 {}
 
-void NPC::init() {
+void NPC::init(const std::shared_ptr<const SpriteResource>& spriteResource,
+        const PolygonResource& bodyHitbox) {
 
-    // get the sprite and texture rectangles according to the type
-    const SpriteResource* spriteResource;
-    if (_TYPE == TYPE::MALE)
-        spriteResource = resourceCache.getResource<SpriteResource>("NPC_MALE_SPRITE");
-    else
-        spriteResource = resourceCache.getResource<SpriteResource>("NPC_FEMALE_SPRITE");
+    // get the sprite and texture rectangles
+    _spriteResource = spriteResource;
     _sprite = spriteResource->sprite;
     _textureRects = spriteResource->textureRects;
 
@@ -74,7 +78,7 @@ void NPC::init() {
     setBodyDef(bodyDef);
 
     // shape definitions
-    b2PolygonShape body = resourceCache.getResource<PolygonResource>("NPC_HITBOX_BODY")->polygon;
+    b2PolygonShape body = bodyHitbox.polygon;
     fitPolygonToSprite(body, _sprite);
     addShape(body);
 
@@ -92,72 +96,59 @@ void NPC::init() {
     _initialized = true;
 }
 
-void NPC::update(const float& timeDelta) {
+void NPC::draw(RenderSnapshot& snapshot, const sf::RenderStates& states) const {
 
     assert(_initialized);
+    
+    snapshot.add(_sprite, states);
+}
 
-    // set the sprite to the current frame
-    _sprite.setTextureRect(_textureRects.at(_currentFrame));
+void NPC::setTimerWheel(TimerWheel* timers) {
 
-    // Increment the frame. Loop the animation only if the NPC isn't starting to throw.
-    _frameTimer += timeDelta;
-    _currentFrame = _startFrame + _frameTimer / _frameDuration;
-    int endFrame = _startFrame + _numFrames - 1;
-    if (_currentFrame > endFrame) {
-        if (_state == STARTING_THROW)
-            _currentFrame = endFrame;
-        else
-            _currentFrame = _startFrame + (_currentFrame - _startFrame) % _numFrames;
-    }
+    assert(_initialized);
 
-    // Decrement the action timer, and if it reaches 0, then set the NPC to idle. Don't do this if
-    // the NPC is starting to throw.
-    _actionTimeRemaining -= timeDelta;
-    if (_actionTimeRemaining <= 0.0f && _state != IDLE && _state != PREPARING) {
-        _actionTimeRemaining = 0.0f;
-        if (_state == STARTING_THROW)
-            _isReadyToFinishThrowing = true;
-        else
-            toIdle();
+    if (_timers) {
+        _timers->cancel(_frameTimer);
+        _timers->cancel(_actionTimer);
+        _timers->cancel(_prepareTimer);
     }
 
-    // Decrement the prepare timer, and when it reaches 0 do the next action, unless that action is
-    // idle.
-    _prepareTimeRemaining -= timeDelta;
-    if (_prepareTimeRemaining <= 0.0f && _nextAction != ACTION::IDLE) {
-
-        _prepareTimeRemaining = 0.0f;
-
-        if (_nextAction == ACTION::WALK)
-            walk(_nextActionDuration);
-        else if (_nextAction == ACTION::START_THROW)
-            startThrowing(_nextActionDuration);
-
-        _nextAction = ACTION::IDLE;
-        _nextActionDuration = 0.0f;
-
-    // set the state to PREPARING if we're waiting to do an action and the current state is IDLE
-    } else if (_prepareTimeRemaining > 0.0f && _state == IDLE) {
-        _state = PREPARING;
-    }
+    // the NPC is made without a wheel, so its animation starts once it gets one
+    _timers = timers;
+    if (_timers)
+        startAnimation(_frameDuration, _startFrame, _numFrames, _currentFrame);
 }
 
-void NPC::draw(sf::RenderTarget& target, sf::RenderStates states) const {
+void NPC::setAnimated(const bool& animated) {
 
-    assert(_initialized);
-    
-    target.draw(_sprite, states);
+    if (animated == _isAnimated)
+        return;
+    _isAnimated = animated;
+
+    if (!_timers)
+        return;
+    if (_isAnimated)
+        syncAnimation();
+    else
+        _timers->cancel(_frameTimer);
 }
 
 void NPC::doAction(const NPC::ACTION& action, const float& delay, const float& duration) {
 
+    assert(_timers);
+
     if (action == ACTION::FINISH_THROW) {
         finishThrowing();
 
     } else {
         _nextAction = action;
-        _prepareTimeRemaining = delay;
         _nextActionDuration = duration;
+        _timers->cancel(_prepareTimer);
+        _prepareTimer = _timers->schedule(delay, [this]() { startNextAction(); });
+
+        // visually the NPC keeps idling while it waits to do the action
+        if (_state == IDLE)
+            _state = PREPARING;
     }
 }
 
@@ -172,12 +163,12 @@ void NPC::stopWalking() {
 
     if (isWalking()) {
 
-        toIdle();
-        
         if (_nextAction == ACTION::WALK) {
-            _nextAction == ACTION::IDLE;
-            _prepareTimeRemaining = 0.0f;
+            _nextAction = ACTION::IDLE;
+            _timers->cancel(_prepareTimer);
         }
+
+        toIdle();
     }
 }
 
@@ -187,14 +178,11 @@ void NPC::walk(const float& duration) {
 
         _state = WALKING;
         _isReadyToFinishThrowing = false;
+        startAnimation(_WALK_FRAME_DURATION, _WALK_START_FRAME, _NUM_WALK_FRAMES,
+                _WALK_START_FRAME);
 
-        _frameDuration = _WALK_FRAME_DURATION;
-        _startFrame = _WALK_START_FRAME;
-        _numFrames = _NUM_WALK_FRAMES;
-        _currentFrame = _startFrame;
-
-        _frameTimer = 0.0f;
-        _actionTimeRemaining = duration;
+        _timers->cancel(_actionTimer);
+        _actionTimer = _timers->schedule(duration, [this]() { finishAction(); });
     }
 }
 
@@ -202,39 +190,107 @@ void NPC::startThrowing(const float& duration) {
 
     _state = STARTING_THROW;
     _isReadyToFinishThrowing = false;
+    startAnimation(_THROW_FRAME_DURATION, _START_THROW_START_FRAME, _NUM_START_THROW_FRAMES,
+            _START_THROW_START_FRAME);
 
-    _frameDuration = _THROW_FRAME_DURATION;
-    _startFrame = _START_THROW_START_FRAME;
-    _numFrames = _NUM_START_THROW_FRAMES;
-    _currentFrame = _startFrame;
-
-    _frameTimer = 0.0f;
-    _actionTimeRemaining = duration;
+    _timers->cancel(_actionTimer);
+    _actionTimer = _timers->schedule(duration, [this]() { finishAction(); });
 }
 
 void NPC::finishThrowing() {
 
     _state = FINISHING_THROW;
     _isReadyToFinishThrowing = false;
+    startAnimation(_THROW_FRAME_DURATION, _FINISH_THROW_START_FRAME, _NUM_FINISH_THROW_FRAMES,
+            _FINISH_THROW_START_FRAME);
 
-    _frameDuration = _THROW_FRAME_DURATION;
-    _startFrame = _FINISH_THROW_START_FRAME;
-    _numFrames = _NUM_FINISH_THROW_FRAMES;
-    _currentFrame = _startFrame;
-
-    _frameTimer = 0.0f;
-    _actionTimeRemaining = _numFrames * _frameDuration;
+    _timers->cancel(_actionTimer);
+    _actionTimer = _timers->schedule(_NUM_FINISH_THROW_FRAMES * _THROW_FRAME_DURATION,
+            [this]() { finishAction(); });
 }
 
 void NPC::toIdle() {
 
-    _state = IDLE;
+    // keep on preparing if there's an action waiting to be done
+    bool isPreparing = _timers && _timers->isPending(_prepareTimer);
+    _state = isPreparing ? PREPARING : IDLE;
     _isReadyToFinishThrowing = false;
+    startAnimation(_IDLE_FRAME_DURATION, _IDLE_START_FRAME, _NUM_IDLE_FRAMES,
+            randomInt(_IDLE_START_FRAME, _IDLE_START_FRAME + _NUM_IDLE_FRAMES - 1));
+
+    if (_timers)
+        _timers->cancel(_actionTimer);
+}
+
+void NPC::startAnimation(const float& frameDuration, const int& startFrame, const int& numFrames,
+        const int& currentFrame) {
+
+    _frameDuration = frameDuration;
+    _startFrame = startFrame;
+    _numFrames = numFrames;
+    _currentFrame = currentFrame;
+    _firstFrame = currentFrame;
+
+    if (_timers) {
+        _animationStartTime = _timers->getTime();
+        _timers->cancel(_frameTimer);
+        if (_isAnimated)
+            syncAnimation();
+    }
+}
+
+void NPC::syncAnimation() {
+
+    // count the frames which have passed since the animation started, including any that were
+    // skipped while the NPC wasn't animated
+    double timePassed = _timers->getTime() - _animationStartTime;
+    int framesPassed = (int)(timePassed / _frameDuration);
+    int frame = _firstFrame - _startFrame + framesPassed;
+    if (_state == STARTING_THROW)
+        frame = std::min(frame, _numFrames - 1);
+    else
+        frame %= _numFrames;
+    _currentFrame = _startFrame + frame;
+    _sprite.setTextureRect(_textureRects.at(_currentFrame));
+
+    // the next frame is due when it would have been if the animation had never stopped
+    float delay = _animationStartTime + (framesPassed + 1) * _frameDuration - _timers->getTime();
+    _timers->cancel(_frameTimer);
+    _frameTimer = _timers->schedule(delay, [this]() { advanceFrame(); });
+}
+
+void NPC::advanceFrame() {
+
+    // once the NPC is done raising their arm, the animation holds still until the throw finishes
+    int endFrame = _startFrame + _numFrames - 1;
+    if (_currentFrame == endFrame && _state == STARTING_THROW)
+        return;
+
+    _currentFrame = _currentFrame == endFrame ? _startFrame : _currentFrame + 1;
+    _sprite.setTextureRect(_textureRects.at(_currentFrame));
+    _frameTimer = _timers->schedule(_frameDuration, [this]() { advanceFrame(); });
+}
+
+void NPC::finishAction() {
+
+    // an NPC that's starting to throw waits for the logic to tell them to finish the throw
+    if (_state == STARTING_THROW)
+        _isReadyToFinishThrowing = true;
+    else
+        toIdle();
+}
+
+void NPC::startNextAction() {
+
+    ACTION action = _nextAction;
+    _nextAction = ACTION::IDLE;
 
-    _frameDuration = _IDLE_FRAME_DURATION;
-    _startFrame = _IDLE_START_FRAME;
-    _numFrames = _NUM_IDLE_FRAMES;
-    _currentFrame = randomInt(_startFrame, _startFrame + _numFrames - 1);
+    if (action == ACTION::WALK)
+        walk(_nextActionDuration);
+    else if (action == ACTION::START_THROW)
+        startThrowing(_nextActionDuration);
+    else if (_state == PREPARING)
+        _state = IDLE;
 
-    _frameTimer = 0.0f;
+    _nextActionDuration = 0.0f;
 }
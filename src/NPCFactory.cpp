@@ -10,14 +10,24 @@
 #include "Resources/SpriteResource.hpp"
 #include "Resources/PolygonResource.hpp"
 
+ResourceHandle<SpriteResource> NPCFactory::_maleSprite;
+ResourceHandle<SpriteResource> NPCFactory::_femaleSprite;
+ResourceHandle<PolygonResource> NPCFactory::_bodyHitbox;
+
+void NPCFactory::init() {
+    _maleSprite = resourceCache.getHandle<SpriteResource>("NPC_MALE_SPRITE");
+    _femaleSprite = resourceCache.getHandle<SpriteResource>("NPC_FEMALE_SPRITE");
+    _bodyHitbox = resourceCache.getHandle<PolygonResource>("NPC_HITBOX_BODY");
+}
+
 std::shared_ptr<NPC> NPCFactory::makeMale() {
     std::shared_ptr<NPC> _mob(new NPC(NPC::TYPE::MALE));
-    _mob->init();
+    _mob->init(resourceCache.acquire(_maleSprite), *resourceCache.get(_bodyHitbox));
     return _mob;
 }
 
 std::shared_ptr<NPC> NPCFactory::makeFemale() {
     std::shared_ptr<NPC> _mob(new NPC(NPC::TYPE::FEMALE));
-    _mob->init();
+    _mob->init(resourceCache.acquire(_femaleSprite), *resourceCache.get(_bodyHitbox));
     return _mob;
 }
@@ -32,36 +32,72 @@ void NPCView::init(GameLogic& logic) {
     _logic = &logic;
 }
 
-void NPCView::update(const float& timeDelta) {
+std::size_t NPCView::startDeciding() {
 
     assert(_initialized);
 
-    for (auto npc : _logic->getNPCs()) {
+    _npcs.assign(_logic->getNPCs().begin(), _logic->getNPCs().end());
+    _decisions.assign(_npcs.size(), Decision{NPC::ACTION::IDLE, 0.0f, 0.0f, false});
+
+    return _npcs.size();
+}
+
+void NPCView::decide(const std::size_t& begin, const std::size_t& end) {
+
+    assert(_initialized);
+    assert(begin <= end && end <= _npcs.size());
+
+    for (std::size_t i = begin; i < end; ++i) {
+
+        NPC& npc = *_npcs[i];
+        Decision& decision = _decisions[i];
 
         // finish throwing if the npc is ready to throw
-        if (npc->isThrowing()) {
-            if (npc->isReadyToFinishThrowing())
-                _logic->requestNPCAction(*npc, NPC::ACTION::FINISH_THROW, 0.0f, 0.0f);
+        if (npc.isThrowing()) {
+            if (npc.isReadyToFinishThrowing())
+                decision.action = NPC::ACTION::FINISH_THROW;
 
-        // if the NPC is idle, then choose to do something
-        } else if (npc->isIdle()) {
+        // If the NPC is idle, then choose to do something. NPCs whose updates are skipped off the
+        // screen just stand around until they're back on it.
+        } else if (npc.isIdle() && !_logic->isSkippingUpdates(npc)) {
 
             // choose whether to make the NPC walk or throw
             float throwChance = clamp(lerp(_EASY_THROW_CHANCE, _HARD_THROW_CHANCE,
                     _logic->getDifficulty()), _EASY_THROW_CHANCE, _HARD_THROW_CHANCE);
-            bool shouldThrow = npc->isVisible && randomFloat(0.0f, 1.0f) <= throwChance;
+            bool shouldThrow = npc.isVisible && randomFloat(0.0f, 1.0f) <= throwChance;
 
             if (shouldThrow) {
-                float throwDuration = clamp(lerp(_EASY_THROW_DURATION, _HARD_THROW_DURATION,
+                decision.action = NPC::ACTION::START_THROW;
+                decision.duration = clamp(lerp(_EASY_THROW_DURATION, _HARD_THROW_DURATION,
                         _logic->getDifficulty()), _HARD_THROW_DURATION, _EASY_THROW_DURATION);
-                _logic->requestNPCAction(*npc, NPC::ACTION::START_THROW, 0.0f, throwDuration);
 
             } else {
-                float walkDelay = randomFloat(0.15f, 1.0f);
-                float walkDuration = 0.95f + randomFloat(-0.25f, 0.25f);
-                npc->setFacingLeft(randomBool());
-                _logic->requestNPCAction(*npc, NPC::ACTION::WALK, walkDelay, walkDuration);
+                decision.action = NPC::ACTION::WALK;
+                decision.delay = randomFloat(0.15f, 1.0f);
+                decision.duration = 0.95f + randomFloat(-0.25f, 0.25f);
+                decision.faceLeft = randomBool();
             }
         }
     }
 }
+
+void NPCView::act() {
+
+    assert(_initialized);
+    assert(_decisions.size() == _npcs.size());
+
+    for (std::size_t i = 0; i < _npcs.size(); ++i) {
+
+        NPC& npc = *_npcs[i];
+        const Decision& decision = _decisions[i];
+
+        if (decision.action == NPC::ACTION::WALK)
+            npc.setFacingLeft(decision.faceLeft);
+        if (decision.action != NPC::ACTION::IDLE)
+            _logic->requestNPCAction(npc, decision.action, decision.delay, decision.duration);
+    }
+
+    // don't hold on to NPCs which the logic may remove
+    _npcs.clear();
+    _decisions.clear();
+}
@@ -1,6 +1,7 @@
 #include <cassert>
 #include <array>
 #include <list>
+#include <memory>
 #include <iostream>
 
 #include <SFML/Graphics.hpp>
@@ -11,12 +12,13 @@
 
 Obstacle::Obstacle(
     const PhysicalActor::TYPE& type,
-    const sf::Texture& texture,
+    const std::shared_ptr<const SpriteResource>& spriteResource,
     const sf::Vector2f& scale
 ) :
     PhysicalActor(type),
 
-    _TEXTURE(texture),
+    _SPRITE_RESOURCE(spriteResource),
+    _TEXTURE(spriteResource->texture->texture),
     _SCALE(scale)
 {
     _vertices.setPrimitiveType(sf::Quads);
@@ -24,12 +26,13 @@ Obstacle::Obstacle(
 
 Obstacle::Obstacle(
     const PhysicalActor::TYPE& type,
-    const sf::Texture& texture,
+    const std::shared_ptr<const SpriteResource>& spriteResource,
     const float& scaleFactor
 ) :
     PhysicalActor(type),
 
-    _TEXTURE(texture),
+    _SPRITE_RESOURCE(spriteResource),
+    _TEXTURE(spriteResource->texture->texture),
     _SCALE(sf::Vector2f(scaleFactor, scaleFactor))
 {
     _vertices.setPrimitiveType(sf::Quads);
@@ -91,7 +94,8 @@ void Obstacle::addComponent(const sf::IntRect& textureRect, const b2FixtureDef&
     }
 }
 
-void Obstacle::draw(sf::RenderTarget& target, sf::RenderStates states) const {
-    states.texture = &_TEXTURE;
-    target.draw(_vertices, states);
+void Obstacle::draw(RenderSnapshot& snapshot, const sf::RenderStates& states) const {
+    sf::RenderStates texturedStates = states;
+    texturedStates.texture = &_TEXTURE;
+    snapshot.add(_vertices, texturedStates);
 }
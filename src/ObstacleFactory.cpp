@@ -13,17 +13,77 @@
 #include "Resources/PolygonResource.hpp"
 #include "Resources/TextureResource.hpp"
 
+ResourceHandle<SpriteResource> ObstacleFactory::_streetlightSprite;
+ResourceHandle<SpriteResource> ObstacleFactory::_groundSprite;
+ResourceHandle<SpriteResource> ObstacleFactory::_bigGroundSprite;
+ResourceHandle<SpriteResource> ObstacleFactory::_poopSprite;
+ResourceHandle<SpriteResource> ObstacleFactory::_splatterSprite;
+ResourceHandle<SpriteResource> ObstacleFactory::_treeSprite;
+ResourceHandle<SpriteResource> ObstacleFactory::_cloudSprite;
+ResourceHandle<SpriteResource> ObstacleFactory::_docksSprite;
+ResourceHandle<SpriteResource> ObstacleFactory::_lifeguardSprite;
+ResourceHandle<SpriteResource> ObstacleFactory::_rockSprite;
+ResourceHandle<SpriteResource> ObstacleFactory::_umbrellaSprite;
+ResourceHandle<PolygonResource> ObstacleFactory::_fullHitbox;
+ResourceHandle<PolygonResource> ObstacleFactory::_octagonHitbox;
+ResourceHandle<PolygonResource> ObstacleFactory::_slantedHitbox;
+ResourceHandle<PolygonResource> ObstacleFactory::_streetlightBaseHitbox;
+ResourceHandle<PolygonResource> ObstacleFactory::_streetlightTopHitbox1;
+ResourceHandle<PolygonResource> ObstacleFactory::_streetlightTopHitbox2;
+ResourceHandle<PolygonResource> ObstacleFactory::_streetlightTopHitbox3;
+ResourceHandle<PolygonResource> ObstacleFactory::_splatterHitbox;
+ResourceHandle<PolygonResource> ObstacleFactory::_treetopHitbox;
+ResourceHandle<PolygonResource> ObstacleFactory::_cloudHitbox;
+ResourceHandle<PolygonResource> ObstacleFactory::_lifeguardRampHitbox;
+ResourceHandle<PolygonResource> ObstacleFactory::_lifeguardPlatformHitbox;
+ResourceHandle<PolygonResource> ObstacleFactory::_lifeguardBuildingHitbox;
+ResourceHandle<PolygonResource> ObstacleFactory::_umbrellaHitbox;
+
+void ObstacleFactory::init() {
+
+    // sprites
+    _streetlightSprite = resourceCache.getHandle<SpriteResource>("STREETLIGHT_SPRITE");
+    _groundSprite = resourceCache.getHandle<SpriteResource>("GROUND_SPRITE");
+    _bigGroundSprite = resourceCache.getHandle<SpriteResource>("BIG_GROUND_SPRITE");
+    _poopSprite = resourceCache.getHandle<SpriteResource>("POOP_SPRITE");
+    _splatterSprite = resourceCache.getHandle<SpriteResource>("SPLATTER_SPRITE");
+    _treeSprite = resourceCache.getHandle<SpriteResource>("TREE_SPRITE");
+    _cloudSprite = resourceCache.getHandle<SpriteResource>("CLOUD_SPRITE");
+    _docksSprite = resourceCache.getHandle<SpriteResource>("DOCKS_SPRITE");
+    _lifeguardSprite = resourceCache.getHandle<SpriteResource>("LIFEGUARD_SPRITE");
+    _rockSprite = resourceCache.getHandle<SpriteResource>("ROCK_SPRITE");
+    _umbrellaSprite = resourceCache.getHandle<SpriteResource>("UMBRELLA_SPRITE");
+
+    // hitboxes
+    _fullHitbox = resourceCache.getHandle<PolygonResource>("FULL_HITBOX");
+    _octagonHitbox = resourceCache.getHandle<PolygonResource>("OCTAGON_HITBOX");
+    _slantedHitbox = resourceCache.getHandle<PolygonResource>("SLANTED_HITBOX");
+    _streetlightBaseHitbox = resourceCache.getHandle<PolygonResource>("STREETLIGHT_BASE_HITBOX");
+    _streetlightTopHitbox1 = resourceCache.getHandle<PolygonResource>("STREETLIGHT_TOP_HITBOX_1");
+    _streetlightTopHitbox2 = resourceCache.getHandle<PolygonResource>("STREETLIGHT_TOP_HITBOX_2");
+    _streetlightTopHitbox3 = resourceCache.getHandle<PolygonResource>("STREETLIGHT_TOP_HITBOX_3");
+    _splatterHitbox = resourceCache.getHandle<PolygonResource>("SPLATTER_HITBOX");
+    _treetopHitbox = resourceCache.getHandle<PolygonResource>("TREETOP_HITBOX");
+    _cloudHitbox = resourceCache.getHandle<PolygonResource>("CLOUD_HITBOX");
+    _lifeguardRampHitbox = resourceCache.getHandle<PolygonResource>("LIFEGUARD_RAMP_HITBOX");
+    _lifeguardPlatformHitbox =
+            resourceCache.getHandle<PolygonResource>("LIFEGUARD_PLATFORM_HITBOX");
+    _lifeguardBuildingHitbox =
+            resourceCache.getHandle<PolygonResource>("LIFEGUARD_BUILDING_HITBOX");
+    _umbrellaHitbox = resourceCache.getHandle<PolygonResource>("UMBRELLA_HITBOX");
+}
+
 std::shared_ptr<Obstacle> ObstacleFactory::makeStreetlight(const float& heightMeters,
         const bool& faceLeft) {
 
     // retrieve the streetlight sprite resource
-    const SpriteResource& spriteResource =
-            *resourceCache.getResource<SpriteResource>("STREETLIGHT_SPRITE");
+    std::shared_ptr<const SpriteResource> sprite = resourceCache.acquire(_streetlightSprite);
+    const SpriteResource& spriteResource = *sprite;
 
     // create the streetlight obstacle
     std::shared_ptr<Obstacle> streetlight(new Obstacle(
         PhysicalActor::TYPE::GENERIC_OBSTACLE,
-        *spriteResource.sprite.getTexture(),
+        sprite,
         sf::Vector2f((faceLeft ? -1.0f : 1.0f) * spriteResource.scaleFactor, spriteResource.scaleFactor)
     ));
 
@@ -42,7 +102,7 @@ std::shared_ptr<Obstacle> ObstacleFactory::makeStreetlight(const float& heightMe
     streetlight->addComponent(
         baseRect,
         fixtureDef,
-        {resourceCache.getResource<PolygonResource>("STREETLIGHT_BASE_HITBOX")->polygon},
+        {resourceCache.get(_streetlightBaseHitbox)->polygon},
         -baseOrigin
     );
 
@@ -59,7 +119,7 @@ std::shared_ptr<Obstacle> ObstacleFactory::makeStreetlight(const float& heightMe
         streetlight->addComponent(
             shaftRect,
             fixtureDef,
-            {resourceCache.getResource<PolygonResource>("FULL_HITBOX")->polygon},
+            {resourceCache.get(_fullHitbox)->polygon},
             -shaftOrigin
         );
     }
@@ -70,9 +130,9 @@ std::shared_ptr<Obstacle> ObstacleFactory::makeStreetlight(const float& heightMe
         topRect,
         fixtureDef,
         {
-            resourceCache.getResource<PolygonResource>("STREETLIGHT_TOP_HITBOX_1")->polygon,
-            resourceCache.getResource<PolygonResource>("STREETLIGHT_TOP_HITBOX_2")->polygon,
-            resourceCache.getResource<PolygonResource>("STREETLIGHT_TOP_HITBOX_3")->polygon
+            resourceCache.get(_streetlightTopHitbox1)->polygon,
+            resourceCache.get(_streetlightTopHitbox2)->polygon,
+            resourceCache.get(_streetlightTopHitbox3)->polygon
         },
         -topOrigin
     );
@@ -88,8 +148,8 @@ std::shared_ptr<Obstacle> ObstacleFactory::makeStreetlight(const float& heightMe
 std::shared_ptr<Obstacle> ObstacleFactory::makeGround(const float& widthMeters) {
 
     // get the ground's sprite resource
-    const SpriteResource& spriteResource =
-            *resourceCache.getResource<SpriteResource>("GROUND_SPRITE");
+    std::shared_ptr<const SpriteResource> sprite = resourceCache.acquire(_groundSprite);
+    const SpriteResource& spriteResource = *sprite;
     
     // determine scale such that the ground's width will be correct
     const sf::IntRect& textureRect = spriteResource.textureRects.at(0);
@@ -98,7 +158,7 @@ std::shared_ptr<Obstacle> ObstacleFactory::makeGround(const float& widthMeters)
     // create the ground obstacle
     std::shared_ptr<Obstacle> ground(new Obstacle(
         PhysicalActor::TYPE::GROUND,
-        *spriteResource.sprite.getTexture(),
+        sprite,
         scale
     ));
 
@@ -110,7 +170,7 @@ std::shared_ptr<Obstacle> ObstacleFactory::makeGround(const float& widthMeters)
     // Ground only has one component; it's origin should be at the top right. Scale the hitbox
     // smaller vertically because these grounds are below the npcGround.
     sf::Vector2f origin(textureRect.width, 0.0f);
-    b2PolygonShape hitbox = resourceCache.getResource<PolygonResource>("FULL_HITBOX")->polygon;
+    b2PolygonShape hitbox = resourceCache.get(_fullHitbox)->polygon;
     scalePolygon(hitbox, b2Vec2(1.0f, 0.975f));
     ground->addComponent(
         textureRect,
@@ -130,8 +190,8 @@ std::shared_ptr<Obstacle> ObstacleFactory::makeGround(const float& widthMeters)
 std::shared_ptr<Obstacle> ObstacleFactory::makeNPCGround(const float& widthMeters) {
 
     // get the ground's sprite resource
-    const SpriteResource& spriteResource =
-            *resourceCache.getResource<SpriteResource>("BIG_GROUND_SPRITE");
+    std::shared_ptr<const SpriteResource> sprite = resourceCache.acquire(_bigGroundSprite);
+    const SpriteResource& spriteResource = *sprite;
     
     // determine scale such that the ground's width will be correct
     const sf::IntRect& textureRect = spriteResource.textureRects.at(0);
@@ -140,7 +200,7 @@ std::shared_ptr<Obstacle> ObstacleFactory::makeNPCGround(const float& widthMeter
     // create the obstacle
     std::shared_ptr<Obstacle> ground(new Obstacle(
         PhysicalActor::TYPE::GROUND,
-        *spriteResource.sprite.getTexture(),
+        sprite,
         scale
     ));
     
@@ -158,7 +218,7 @@ std::shared_ptr<Obstacle> ObstacleFactory::makeNPCGround(const float& widthMeter
     ground->addComponent(
         textureRect,
         fixtureDef,
-        {resourceCache.getResource<PolygonResource>("FULL_HITBOX")->polygon},
+        {resourceCache.get(_fullHitbox)->polygon},
         -origin
     );
 
@@ -173,13 +233,13 @@ std::shared_ptr<Obstacle> ObstacleFactory::makeNPCGround(const float& widthMeter
 std::shared_ptr<Obstacle> ObstacleFactory::makePoop(const float& yVelocity) {
 
     // get the poop's sprite resource
-    const SpriteResource& spriteResource =
-            *resourceCache.getResource<SpriteResource>("POOP_SPRITE");
+    std::shared_ptr<const SpriteResource> sprite = resourceCache.acquire(_poopSprite);
+    const SpriteResource& spriteResource = *sprite;
     
     // make the poop obstacle
     std::shared_ptr<Obstacle> poop(new Obstacle(
         PhysicalActor::TYPE::POOP,
-        *spriteResource.sprite.getTexture(),
+        sprite,
         spriteResource.scaleFactor
     ));
 
@@ -194,7 +254,7 @@ std::shared_ptr<Obstacle> ObstacleFactory::makePoop(const float& yVelocity) {
     poop->addComponent(
         textureRect,
         fixtureDef,
-        {resourceCache.getResource<PolygonResource>("OCTAGON_HITBOX")->polygon},
+        {resourceCache.get(_octagonHitbox)->polygon},
         -origin
     );
 
@@ -212,15 +272,15 @@ std::shared_ptr<Obstacle> ObstacleFactory::makePoop(const float& yVelocity) {
 std::shared_ptr<Obstacle> ObstacleFactory::makePoopSplatter() {
     //functions similarly to a ground obstacle but with a different texture
         // get the ground's sprite resource
-    const SpriteResource& spriteResource =
-            *resourceCache.getResource<SpriteResource>("SPLATTER_SPRITE");
+    std::shared_ptr<const SpriteResource> sprite = resourceCache.acquire(_splatterSprite);
+    const SpriteResource& spriteResource = *sprite;
     
     // determine scale such that the ground's width will be correct
     const sf::IntRect& textureRect = spriteResource.textureRects.at(0);
     // create the ground obstacle
     std::shared_ptr<Obstacle> ground(new Obstacle(
         PhysicalActor::TYPE::GENERIC_OBSTACLE,
-        *spriteResource.sprite.getTexture(),
+        sprite,
         spriteResource.scaleFactor
     ));
 
@@ -234,7 +294,7 @@ std::shared_ptr<Obstacle> ObstacleFactory::makePoopSplatter() {
     ground->addComponent(
         textureRect,
         fixtureDef,
-        {resourceCache.getResource<PolygonResource>("SPLATTER_HITBOX")->polygon},
+        {resourceCache.get(_splatterHitbox)->polygon},
         -origin
     );
 
@@ -247,11 +307,11 @@ std::shared_ptr<Obstacle> ObstacleFactory::makePoopSplatter() {
 }
 
 std::shared_ptr<Obstacle> ObstacleFactory::makeTree(const float& heightMeters, const bool& faceLeft) {
-    const SpriteResource& spriteResource =
-            *resourceCache.getResource<SpriteResource>("TREE_SPRITE");
+    std::shared_ptr<const SpriteResource> sprite = resourceCache.acquire(_treeSprite);
+    const SpriteResource& spriteResource = *sprite;
     std::shared_ptr<Obstacle> tree(new Obstacle(
         PhysicalActor::TYPE::GENERIC_OBSTACLE,
-        *spriteResource.sprite.getTexture(),
+        sprite,
         sf::Vector2f((faceLeft ? -1.0f : 1.0f) * spriteResource.scaleFactor, spriteResource.scaleFactor)
     ));
     const sf::IntRect& baseRect = spriteResource.textureRects.at(0);
@@ -263,7 +323,7 @@ std::shared_ptr<Obstacle> ObstacleFactory::makeTree(const float& heightMeters, c
     tree->addComponent(
         baseRect,
         fixtureDef,
-        {resourceCache.getResource<PolygonResource>("STREETLIGHT_BASE_HITBOX")->polygon},
+        {resourceCache.get(_streetlightBaseHitbox)->polygon},
         -baseOrigin
     );
     int numShafts = (heightMeters * PIXELS_PER_METER / spriteResource.scaleFactor -
@@ -277,7 +337,7 @@ std::shared_ptr<Obstacle> ObstacleFactory::makeTree(const float& heightMeters, c
         tree->addComponent(
             shaftRect,
             fixtureDef,
-            {resourceCache.getResource<PolygonResource>("SLANTED_HITBOX")->polygon},
+            {resourceCache.get(_slantedHitbox)->polygon},
             -bodyOrigin
         );
     }
@@ -286,7 +346,7 @@ std::shared_ptr<Obstacle> ObstacleFactory::makeTree(const float& heightMeters, c
     tree->addComponent(
         topRect,
         fixtureDef,
-        {resourceCache.getResource<PolygonResource>("TREETOP_HITBOX")->polygon},
+        {resourceCache.get(_treetopHitbox)->polygon},
         -topOrigin
     );
     b2BodyDef bodyDef;
@@ -296,11 +356,11 @@ std::shared_ptr<Obstacle> ObstacleFactory::makeTree(const float& heightMeters, c
 }
 
 std::shared_ptr<Obstacle> ObstacleFactory::makeCloud() {
-    const SpriteResource& spriteResource =
-            *resourceCache.getResource<SpriteResource>("CLOUD_SPRITE");
+    std::shared_ptr<const SpriteResource> sprite = resourceCache.acquire(_cloudSprite);
+    const SpriteResource& spriteResource = *sprite;
     std::shared_ptr<Obstacle> cloud(new Obstacle(
         PhysicalActor::TYPE::GENERIC_OBSTACLE,
-        *spriteResource.sprite.getTexture(),
+        sprite,
         spriteResource.scaleFactor
     ));
 
@@ -310,7 +370,7 @@ std::shared_ptr<Obstacle> ObstacleFactory::makeCloud() {
     cloud->addComponent(
         textureRect,
         fixtureDef,
-        {resourceCache.getResource<PolygonResource>("CLOUD_HITBOX")->polygon},
+        {resourceCache.get(_cloudHitbox)->polygon},
         -origin
     );
     b2BodyDef bodyDef;
@@ -321,11 +381,11 @@ std::shared_ptr<Obstacle> ObstacleFactory::makeCloud() {
 }
 
 std::shared_ptr<Obstacle> ObstacleFactory::makeDocks(const int& numCols, const int& numRows) {
-    const SpriteResource& spriteResource =
-            *resourceCache.getResource<SpriteResource>("DOCKS_SPRITE");
+    std::shared_ptr<const SpriteResource> sprite = resourceCache.acquire(_docksSprite);
+    const SpriteResource& spriteResource = *sprite;
     std::shared_ptr<Obstacle> docks(new Obstacle(
         PhysicalActor::TYPE::GENERIC_OBSTACLE,
-        *spriteResource.sprite.getTexture(),
+        sprite,
         spriteResource.scaleFactor
     ));
     const sf::IntRect& leftTopRect = spriteResource.textureRects.at(0);
@@ -401,7 +461,7 @@ std::shared_ptr<Obstacle> ObstacleFactory::makeDocks(const int& numCols, const i
     bodyDef.type = b2_kinematicBody;
 
     // make the hitbox just one big slab
-    b2PolygonShape hitbox = resourceCache.getResource<PolygonResource>("FULL_HITBOX")->polygon;
+    b2PolygonShape hitbox = resourceCache.get(_fullHitbox)->polygon;
     translatePolygon(hitbox, b2Vec2(0.5f, -0.5f));
     scalePolygon(hitbox, spriteResource.scaleFactor * METERS_PER_PIXEL * b2Vec2(
         leftBottomRect.width + (numCols <= 2 ? 0 : (numCols - 2)) * middleBottomRect.width + rightBottomRect.width,
@@ -419,11 +479,11 @@ std::shared_ptr<Obstacle> ObstacleFactory::makeDocks(const int& numCols, const i
 }
 
 std::shared_ptr<Obstacle> ObstacleFactory::makeLifeguard(const bool& faceLeft) {
-    const SpriteResource& spriteResource =
-            *resourceCache.getResource<SpriteResource>("LIFEGUARD_SPRITE");
+    std::shared_ptr<const SpriteResource> sprite = resourceCache.acquire(_lifeguardSprite);
+    const SpriteResource& spriteResource = *sprite;
     std::shared_ptr<Obstacle> lifeguard(new Obstacle(
         PhysicalActor::TYPE::GENERIC_OBSTACLE,
-        *spriteResource.sprite.getTexture(),
+        sprite,
         sf::Vector2f((faceLeft ? -1.0f : 1.0f) * spriteResource.scaleFactor, spriteResource.scaleFactor)
     ));
 
@@ -437,9 +497,9 @@ std::shared_ptr<Obstacle> ObstacleFactory::makeLifeguard(const bool& faceLeft) {
         textureRect,
         fixtureDef,
         {
-            resourceCache.getResource<PolygonResource>("LIFEGUARD_RAMP_HITBOX")->polygon,
-            resourceCache.getResource<PolygonResource>("LIFEGUARD_PLATFORM_HITBOX")->polygon,
-            resourceCache.getResource<PolygonResource>("LIFEGUARD_BUILDING_HITBOX")->polygon
+            resourceCache.get(_lifeguardRampHitbox)->polygon,
+            resourceCache.get(_lifeguardPlatformHitbox)->polygon,
+            resourceCache.get(_lifeguardBuildingHitbox)->polygon
         },
         -origin
     );
@@ -452,11 +512,11 @@ std::shared_ptr<Obstacle> ObstacleFactory::makeLifeguard(const bool& faceLeft) {
 }
 
 std::shared_ptr<Obstacle> ObstacleFactory::makeRock(){
-    const SpriteResource& spriteResource =
-        *resourceCache.getResource<SpriteResource>("ROCK_SPRITE");
+    std::shared_ptr<const SpriteResource> sprite = resourceCache.acquire(_rockSprite);
+    const SpriteResource& spriteResource = *sprite;
     
     std::shared_ptr<Obstacle> rock(new Obstacle(
-        PhysicalActor::TYPE::PROJECTILE,*spriteResource.sprite.getTexture(),
+        PhysicalActor::TYPE::PROJECTILE,sprite,
         spriteResource.scaleFactor
     ));
 
@@ -468,7 +528,7 @@ std::shared_ptr<Obstacle> ObstacleFactory::makeRock(){
     fixtureDef.restitution = 0.3f;
 
     // rock also only has one component, origin should be in the middle
-    b2PolygonShape hitbox = resourceCache.getResource<PolygonResource>("OCTAGON_HITBOX")->polygon;
+    b2PolygonShape hitbox = resourceCache.get(_octagonHitbox)->polygon;
     scalePolygon(hitbox, b2Vec2(0.8f, 0.8f));
     const sf::IntRect& textureRect = spriteResource.textureRects.at(0);
     sf::Vector2f origin(textureRect.width / 2.0f, textureRect.height / 2.0f);
@@ -489,11 +549,11 @@ std::shared_ptr<Obstacle> ObstacleFactory::makeRock(){
 }
 
 std::shared_ptr<Obstacle> ObstacleFactory::makeUmbrella(const float angle) {
-    const SpriteResource& spriteResource =
-        *resourceCache.getResource<SpriteResource>("UMBRELLA_SPRITE");
+    std::shared_ptr<const SpriteResource> sprite = resourceCache.acquire(_umbrellaSprite);
+    const SpriteResource& spriteResource = *sprite;
     
     std::shared_ptr<Obstacle> umbrella(new Obstacle(
-        PhysicalActor::TYPE::GENERIC_OBSTACLE,*spriteResource.sprite.getTexture(),
+        PhysicalActor::TYPE::GENERIC_OBSTACLE,sprite,
         spriteResource.scaleFactor
     ));
 
@@ -504,7 +564,7 @@ std::shared_ptr<Obstacle> ObstacleFactory::makeUmbrella(const float angle) {
     umbrella->addComponent(
         textureRect,
         fixtureDef,
-        {resourceCache.getResource<PolygonResource>("UMBRELLA_HITBOX")->polygon},
+        {resourceCache.get(_umbrellaHitbox)->polygon},
         -origin
     );
     b2BodyDef bodyDef;
@@ -9,6 +9,7 @@
 #include "Globals.hpp"
 #include "Utils.hpp"
 #include "GameLogic.hpp"
+#include "TimerWheel.hpp"
 #include "Resources/SpriteResource.hpp"
 #include "Resources/PolygonResource.hpp"
 
@@ -24,7 +25,8 @@ PlayableBird::PlayableBird() :
     _FALLING_FRAME(2),
     _FLYING_FRAME_DURATION(0.04f),
     _currentFlyingFrame(0),
-    _frameTimer(0.0f),
+    _timers(nullptr),
+    _frameTimer(TimerWheel::NO_TIMER),
 
     _isFlying(false),
     _isPooping(false),
@@ -34,8 +36,8 @@ PlayableBird::PlayableBird() :
 void PlayableBird::init() {
 
     // get the sprite and texture rectangles
-    const SpriteResource& spriteResource =
-            *resourceCache.getResource<SpriteResource>("BIRD_SPRITE");
+    _spriteResource = resourceCache.acquire<SpriteResource>("BIRD_SPRITE");
+    const SpriteResource& spriteResource = *_spriteResource;
     _sprite = spriteResource.sprite;
     _textureRects = spriteResource.textureRects;
 
@@ -69,39 +71,25 @@ void PlayableBird::init() {
     _initialized = true;
 }
 
-void PlayableBird::update(const float& timeDelta) {
+void PlayableBird::setTimerWheel(TimerWheel* timers) {
 
     assert(_initialized);
 
-    // If the bird is flying, advance the frame change timer and increment the current frame if it
-    // exceeds _FLYING_FRAME_DURATION
-    if (_isFlying) {
-        _frameTimer += timeDelta;
-        if (_frameTimer >= _FLYING_FRAME_DURATION) {
-            _currentFlyingFrame = (_currentFlyingFrame + 1) % _FLYING_FRAMES.size();
-            _frameTimer = 0.0f;
-        }
-    }
-
-    // only set the bird's frame if it isn't dead
-    if (!_isDead) {
-
-        // determine which starting frame to use; is either the start of the mouth closed flying
-        // sequence or the start of the mouth open one
-        int startFrame = _isPooping ? _FLYING_OPEN_START_FRAME : _FLYING_CLOSED_START_FRAME;
+    if (_timers)
+        _timers->cancel(_frameTimer);
 
-        // determine the actual frame and set the texture rectangle
-        int frame = startFrame + _FLYING_FRAMES.at(_currentFlyingFrame);
-        _sprite.setTextureRect(_textureRects.at(frame));
-    }
+    // keep flapping on the new wheel
+    _timers = timers;
+    if (_timers && _isFlying)
+        _frameTimer = _timers->schedule(_FLYING_FRAME_DURATION, [this]() { advanceFrame(); });
 }
 
-void PlayableBird::draw(sf::RenderTarget& target, sf::RenderStates states) const {
+void PlayableBird::draw(RenderSnapshot& snapshot, const sf::RenderStates& states) const {
 
     assert(_initialized);
     
     // draw sprite
-    target.draw(_sprite, states);
+    snapshot.add(_sprite, states);
 }
 
 void PlayableBird::startFlying() {
@@ -110,11 +98,15 @@ void PlayableBird::startFlying() {
     // natural when it starts to flap its wings
     _currentFlyingFrame = _FLYING_FRAMES.at(3);
 
-    // reset the frame timer
-    _frameTimer = 0.0f;
+    // restart the frame timer
+    if (_timers) {
+        _timers->cancel(_frameTimer);
+        _frameTimer = _timers->schedule(_FLYING_FRAME_DURATION, [this]() { advanceFrame(); });
+    }
 
     _isFlying = true;
     _isDead = false;
+    updateTextureRect();
 }
 
 void PlayableBird::stopFlying() {
@@ -122,17 +114,22 @@ void PlayableBird::stopFlying() {
     // set the frame to where the wings are in the middle, so it's kind of like the wings are
     // "tucked in" while falling
     _currentFlyingFrame = _FLYING_FRAMES.at(2);
+    if (_timers)
+        _timers->cancel(_frameTimer);
 
     _isFlying = false;
+    updateTextureRect();
 }
 
 void PlayableBird::startPooping() {
     _isPooping = true;
     _isDead = false;
+    updateTextureRect();
 }
 
 void PlayableBird::stopPooping() {
     _isPooping = false;
+    updateTextureRect();
 }
 
 void PlayableBird::die() {
@@ -142,3 +139,26 @@ void PlayableBird::die() {
 
     _isDead = true;
 }
+
+void PlayableBird::advanceFrame() {
+
+    _currentFlyingFrame = (_currentFlyingFrame + 1) % _FLYING_FRAMES.size();
+    updateTextureRect();
+
+    _frameTimer = _timers->schedule(_FLYING_FRAME_DURATION, [this]() { advanceFrame(); });
+}
+
+void PlayableBird::updateTextureRect() {
+
+    // only set the bird's frame if it isn't dead
+    if (!_isDead) {
+
+        // determine which starting frame to use; is either the start of the mouth closed flying
+        // sequence or the start of the mouth open one
+        int startFrame = _isPooping ? _FLYING_OPEN_START_FRAME : _FLYING_CLOSED_START_FRAME;
+
+        // determine the actual frame and set the texture rectangle
+        int frame = startFrame + _FLYING_FRAMES.at(_currentFlyingFrame);
+        _sprite.setTextureRect(_textureRects.at(frame));
+    }
+}
@@ -1,16 +1,27 @@
 #include <cassert>
+#include <cmath>
+#include <algorithm>
+#include <vector>
+#include <cstddef>
 
 #include <SFML/Graphics.hpp>
 #include <box2d/box2d.h>
 
 #include "PlayingActivity.hpp"
 #include "Globals.hpp"
+#include "JobSystem.hpp"
+#include "ResourceCache.hpp"
 #include "Resources/SpriteResource.hpp"
 #include "Event.hpp"
 #include "Events/GameOverEvent.hpp"
 
 PlayingActivity::PlayingActivity() :
     _initialized(false),
+    _jobSystem(nullptr),
+    _demoTime(0.0f),
+    _DEMO_LENGTH(30.0f),
+    _fadeInTime(0.0f),
+    _FADE_DURATION(0.5f),
     _currentActivity(nullptr)
 {}
 
@@ -19,9 +30,11 @@ PlayingActivity::~PlayingActivity() {
     eventMessenger.removeListener(GameOverEvent::TYPE, _gameOverListener);
 }
 
-void PlayingActivity::init(sf::RenderTarget& target) {
+void PlayingActivity::init(JobSystem& jobSystem) {
 
     _initialized = true;
+
+    _jobSystem = &jobSystem;
     
     // initialize event listeners and add them to event messenger
     _gameOverListener.init(&PlayingActivity::toGameOver, this);
@@ -30,7 +43,7 @@ void PlayingActivity::init(sf::RenderTarget& target) {
     // initialize logic; if in DEBUG mode, also set its debug drawer
     _logic.init();
     if (DEBUG) {
-        _debugDrawer.init(target);
+        _debugDrawer.init();
         _debugDrawer.SetFlags(b2Draw::e_shapeBit | b2Draw::e_centerOfMassBit);
         _logic.setDebugDrawer(_debugDrawer);
     }
@@ -53,29 +66,119 @@ void PlayingActivity::update(const float& timeDelta) {
     assert(_initialized);
     assert(_currentActivity);
 
-    // update views
-    _humanView.update(timeDelta);
-    _npcView.update(timeDelta);
+    // play back the demo if it's recorded, nothing has to be simulated then
+    if (_currentActivity == &_mainMenuActivity)
+        _demoTime += timeDelta;
+    _fadeInTime = std::max(_fadeInTime - timeDelta, 0.0f);
+    if (isPlayingBackDemo()) {
+        _currentActivity->update(timeDelta);
+        return;
+    }
 
-    // update logic
-    _logic.update(timeDelta);
+    // The NPCs decide what to do next in parallel, each job deciding for a range of them.
+    std::size_t numNPCs = _npcView.startDeciding();
+    std::size_t numChunks = std::min<std::size_t>(numNPCs, _jobSystem->getNumThreads());
+    std::vector<int> decisions;
+    for (std::size_t i = 0; i < numChunks; ++i) {
+        std::size_t begin = numNPCs * i / numChunks;
+        std::size_t end = numNPCs * (i + 1) / numChunks;
+        decisions.push_back(_jobSystem->add("npc decisions", [this, begin, end]() {
+            _npcView.decide(begin, end);
+        }));
+    }
 
-    // update subactivity
+    // Then the views tell the logic what the bird and NPCs should do, and the logic steps the
+    // world. The logic triggers events and may load textures, so it stays on this thread.
+    _jobSystem->addOnCaller("logic", [this, timeDelta]() {
+        _humanView.update(timeDelta);
+        _npcView.act();
+        _logic.update(timeDelta);
+    }, decisions);
+
+    // Meanwhile, the course ahead is planned so that the logic doesn't have to make new obstacles
+    // mid-update. Making them gets resources, which is only safe from a worker if the cache is
+    // frozen; otherwise the planning stays on this thread too.
+    if (resourceCache.isFrozen())
+        _jobSystem->add("plan", [this]() { _logic.planCourse(); });
+    else
+        _jobSystem->addOnCaller("plan", [this]() { _logic.planCourse(); });
+    _jobSystem->run();
+
+    // record the demo until it's long enough to be played back
+    if (_currentActivity == &_mainMenuActivity && _demoRecording.getLength() < _DEMO_LENGTH &&
+            canRecordDemo())
+        _demoRecording.recordFrame(_logic, timeDelta);
+
+    // update subactivity; it may queue events, so it isn't a job
     _currentActivity->update(timeDelta);
 }
 
-void PlayingActivity::draw(sf::RenderTarget& target) {
+void PlayingActivity::draw(RenderSnapshot& snapshot) {
 
     assert(_initialized);
     assert(_currentActivity);
 
     // draw the human view, then the current subactivity on top
-    target.draw(_humanView);
-    _currentActivity->draw(target);
+    if (isPlayingBackDemo()) {
+        _humanView.drawBackground(snapshot);
+        _demoRecording.draw(snapshot, _demoTime);
+    } else {
+        _humanView.draw(snapshot);
+    }
+
+    // fade the world, but not the subactivity
+    float fade = getFade();
+    if (fade > 0.0f) {
+        sf::RectangleShape curtain;
+        curtain.setSize(sf::Vector2f(NATIVE_RESOLUTION));
+        curtain.setFillColor(sf::Color(0, 0, 0, (sf::Uint8)(255.0f * fade)));
+        snapshot.add(curtain);
+    }
+    _currentActivity->draw(snapshot);
 
     // if in DEBUG mode, call the logic's debug draw
-    if (DEBUG)
+    if (DEBUG && !isPlayingBackDemo()) {
+        _debugDrawer.setSnapshot(snapshot);
         _logic.debugDraw();
+    }
+}
+
+bool PlayingActivity::isPlayingBackDemo() const {
+    return _currentActivity == &_mainMenuActivity && _demoRecording.getLength() >= _DEMO_LENGTH;
+}
+
+bool PlayingActivity::canRecordDemo() const {
+    return resourceCache.getTextureBudget() == 0 || resourceCache.isFrozen();
+}
+
+float PlayingActivity::getFade() const {
+
+    // a game started from the recording fades in
+    float fade = _fadeInTime / _FADE_DURATION;
+
+    // The demo fades in at the start of each loop and out at the end, so that the end of the
+    // recording doesn't cut to its start. The first loop is the one that's being recorded.
+    if (_currentActivity == &_mainMenuActivity && canRecordDemo()) {
+        float length = isPlayingBackDemo() ? _demoRecording.getLength() : _DEMO_LENGTH;
+        float time = std::fmod(_demoTime, length);
+        float distance = std::min(time, length - time);
+        fade = std::max(fade, 1.0f - std::min(distance / _FADE_DURATION, 1.0f));
+    }
+
+    return fade;
+}
+
+void PlayingActivity::setCourseFile(const CourseFile* courseFile) {
+    _logic.setCourseFile(courseFile);
+}
+
+void PlayingActivity::printUpdateStats(std::ostream& out) const {
+    _logic.printUpdateStats(out);
+}
+
+bool PlayingActivity::isPaused() const {
+    assert(_initialized);
+    return _logic.isPaused();
 }
 
 void PlayingActivity::toMain() {
@@ -90,8 +193,12 @@ void PlayingActivity::toMain() {
     _currentActivity = &_mainMenuActivity;
     _currentActivity->activate();
 
-    // set logic to demo mode
+    // Set logic to demo mode. A recording that was cut short by leaving the main menu can't be
+    // continued, since the demo starts over.
     _logic.toDemo();
+    _demoTime = 0.0f;
+    if (_demoRecording.getLength() < _DEMO_LENGTH)
+        _demoRecording.clear();
 }
 
 void PlayingActivity::toPlaying() {
@@ -102,6 +209,10 @@ void PlayingActivity::toPlaying() {
     if (_currentActivity)
         _currentActivity->deactivate();
     
+    // The logic wasn't simulated while the recording was played back, so the world jumps back to
+    // where the demo started. Fade that in rather than cutting to it.
+    _fadeInTime = isPlayingBackDemo() ? _FADE_DURATION : 0.0f;
+
     // set current activity to playing menu and activate it
     _currentActivity = &_playingMenuActivity;
     _currentActivity->activate();
@@ -117,6 +228,10 @@ void PlayingActivity::toGameOver(const Event& event) {
     // make sure that the passed event was a GameOverEvent
     assert(event.getType() == GameOverEvent::TYPE);
 
+    // the event is queued, so the game may have been left before it was handled
+    if (_currentActivity != &_playingMenuActivity)
+        return;
+
     // deactivate old activity
     if (_currentActivity)
         _currentActivity->deactivate();
@@ -48,8 +48,8 @@ void PlayingMenuActivity::init(PlayingActivity& playingActivity, const GameLogic
     // retrieve resources
     const FontResource& arcadeFont = *resourceCache.getResource<FontResource>("ARCADE_FONT");
     const FontResource& joystixFont = *resourceCache.getResource<FontResource>("JOYSTIX_FONT");
-    const SpriteResource& indicatorSprite =
-            *resourceCache.getResource<SpriteResource>("CIRCLE_INDICATOR_SPRITE");
+    _indicatorSpriteResource = resourceCache.acquire<SpriteResource>("CIRCLE_INDICATOR_SPRITE");
+    const SpriteResource& indicatorSprite = *_indicatorSpriteResource;
 
     // set up indicators
     _indicatorRects = indicatorSprite.textureRects;
@@ -207,23 +207,23 @@ void PlayingMenuActivity::update(const float& timeDelta) {
     _pauseButton.setString(_logic->isPaused() ? ">" : "||");
 }
 
-void PlayingMenuActivity::draw(sf::RenderTarget& target) {
+void PlayingMenuActivity::draw(RenderSnapshot& snapshot) {
     
     assert(_initialized);
     assert(_activated);
 
     for (sf::Sprite* indicator : _indicators)
-        target.draw(*indicator);
-    target.draw(_poopTimeLeftOutline);
-    target.draw(_poopTimeLeftBar);
-    target.draw(_scoreText);
-    target.draw(_pauseButton);
+        snapshot.add(*indicator);
+    snapshot.add(_poopTimeLeftOutline);
+    snapshot.add(_poopTimeLeftBar);
+    snapshot.add(_scoreText);
+    _pauseButton.draw(snapshot);
 
     // only draw paused stuff if the game is paused
     if (_logic->isPaused()) {
         for (Button* button : _pausedButtons)
-            target.draw(*button);
-        target.draw(_pausedText);
+            button->draw(snapshot);
+        snapshot.add(_pausedText);
     }
 }
 
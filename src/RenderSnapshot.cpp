@@ -0,0 +1,195 @@
+#include <algorithm>
+
+#include <SFML/Graphics.hpp>
+
+#include "RenderSnapshot.hpp"
+#include "Globals.hpp"
+
+RenderSnapshot::RenderSnapshot() :
+    _view(sf::FloatRect(0.0f, 0.0f, NATIVE_RESOLUTION.x, NATIVE_RESOLUTION.y))
+{}
+
+void RenderSnapshot::clear() {
+
+    _commands.clear();
+    _sprites.clear();
+    _texts.clear();
+    _rectangles.clear();
+    _circles.clear();
+    _polygons.clear();
+    _vertexArrays.clear();
+}
+
+void RenderSnapshot::setView(const sf::View& view) {
+    _view = view;
+}
+
+const sf::View& RenderSnapshot::getView() const {
+    return _view;
+}
+
+void RenderSnapshot::add(const sf::Sprite& sprite, const sf::RenderStates& states) {
+    _commands.push_back({SPRITE, _sprites.size(), states});
+    _sprites.push_back(sprite);
+}
+
+void RenderSnapshot::add(const sf::Text& text, const sf::RenderStates& states) {
+
+    // Text is laid out lazily, and laying it out looks up glyphs and kerning through the font's
+    // FreeType face, which isn't thread safe. Lay it out now, so that the copy is drawn as it is
+    // instead of being laid out by the render thread while this thread measures other text.
+    text.getLocalBounds();
+
+    _commands.push_back({TEXT, _texts.size(), states});
+    _texts.push_back(text);
+}
+
+void RenderSnapshot::add(const sf::RectangleShape& rectangle, const sf::RenderStates& states) {
+    _commands.push_back({RECTANGLE, _rectangles.size(), states});
+    _rectangles.push_back(rectangle);
+}
+
+void RenderSnapshot::add(const sf::CircleShape& circle, const sf::RenderStates& states) {
+    _commands.push_back({CIRCLE, _circles.size(), states});
+    _circles.push_back(circle);
+}
+
+void RenderSnapshot::add(const sf::ConvexShape& polygon, const sf::RenderStates& states) {
+    _commands.push_back({CONVEX, _polygons.size(), states});
+    _polygons.push_back(polygon);
+}
+
+void RenderSnapshot::add(const sf::VertexArray& vertices, const sf::RenderStates& states) {
+    _commands.push_back({VERTICES, _vertexArrays.size(), states});
+    _vertexArrays.push_back(vertices);
+}
+
+void RenderSnapshot::add(const RenderSnapshot& other, const sf::RenderStates& states) {
+
+    for (const Command& command : other._commands) {
+
+        // combine the states, the command's own texture and shader take precedence
+        sf::RenderStates combinedStates = command.states;
+        combinedStates.transform = states.transform * command.states.transform;
+        if (!combinedStates.texture)
+            combinedStates.texture = states.texture;
+        if (!combinedStates.shader)
+            combinedStates.shader = states.shader;
+
+        switch (command.type) {
+
+        case SPRITE:
+            add(other._sprites[command.index], combinedStates);
+            break;
+
+        case TEXT:
+            add(other._texts[command.index], combinedStates);
+            break;
+
+        case RECTANGLE:
+            add(other._rectangles[command.index], combinedStates);
+            break;
+
+        case CIRCLE:
+            add(other._circles[command.index], combinedStates);
+            break;
+
+        case CONVEX:
+            add(other._polygons[command.index], combinedStates);
+            break;
+
+        case VERTICES:
+            add(other._vertexArrays[command.index], combinedStates);
+            break;
+        }
+    }
+}
+
+namespace {
+
+bool isSameTransform(const sf::Transform& a, const sf::Transform& b) {
+    return std::equal(a.getMatrix(), a.getMatrix() + 16, b.getMatrix());
+}
+
+bool isSameVertex(const sf::Vertex& a, const sf::Vertex& b) {
+    return a.position == b.position && a.color == b.color && a.texCoords == b.texCoords;
+}
+
+}
+
+bool RenderSnapshot::isSameAs(const RenderSnapshot& other) const {
+
+    if (_commands.size() != other._commands.size())
+        return false;
+
+    for (std::size_t i = 0; i < _commands.size(); ++i) {
+
+        const Command& a = _commands[i];
+        const Command& b = other._commands[i];
+        if (a.type != b.type || a.states.texture != b.states.texture ||
+                a.states.shader != b.states.shader || !(a.states.blendMode == b.states.blendMode) ||
+                !isSameTransform(a.states.transform, b.states.transform))
+            return false;
+
+        if (a.type == SPRITE) {
+            const sf::Sprite& spriteA = _sprites[a.index];
+            const sf::Sprite& spriteB = other._sprites[b.index];
+            if (spriteA.getTexture() != spriteB.getTexture() ||
+                    spriteA.getTextureRect() != spriteB.getTextureRect() ||
+                    spriteA.getColor() != spriteB.getColor() ||
+                    !isSameTransform(spriteA.getTransform(), spriteB.getTransform()))
+                return false;
+
+        } else if (a.type == VERTICES) {
+            const sf::VertexArray& verticesA = _vertexArrays[a.index];
+            const sf::VertexArray& verticesB = other._vertexArrays[b.index];
+            if (verticesA.getPrimitiveType() != verticesB.getPrimitiveType() ||
+                    verticesA.getVertexCount() != verticesB.getVertexCount())
+                return false;
+            for (std::size_t j = 0; j < verticesA.getVertexCount(); ++j) {
+                if (!isSameVertex(verticesA[j], verticesB[j]))
+                    return false;
+            }
+
+        } else {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void RenderSnapshot::draw(sf::RenderTarget& target) const {
+
+    target.setView(_view);
+
+    for (const Command& command : _commands) {
+
+        switch (command.type) {
+
+        case SPRITE:
+            target.draw(_sprites[command.index], command.states);
+            break;
+
+        case TEXT:
+            target.draw(_texts[command.index], command.states);
+            break;
+
+        case RECTANGLE:
+            target.draw(_rectangles[command.index], command.states);
+            break;
+
+        case CIRCLE:
+            target.draw(_circles[command.index], command.states);
+            break;
+
+        case CONVEX:
+            target.draw(_polygons[command.index], command.states);
+            break;
+
+        case VERTICES:
+            target.draw(_vertexArrays[command.index], command.states);
+            break;
+        }
+    }
+}
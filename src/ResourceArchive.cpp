@@ -0,0 +1,73 @@
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <iostream>
+
+#include "ResourceArchive.hpp"
+
+const char ResourceArchive::MAGIC[4] = {'G', 'B', 'R', 'A'};
+
+bool ResourceArchive::open(const std::string& filename) {
+
+    close();
+
+    if (!_file.open(filename))
+        return false;
+
+    const unsigned char* data = _file.getData();
+    std::size_t size = _file.getSize();
+
+    // check the header
+    std::uint32_t version = 0;
+    std::uint32_t numEntries = 0;
+    std::uint64_t manifestHash = 0;
+    if (size >= HEADER_SIZE) {
+        std::memcpy(&version, data + 4, sizeof(version));
+        std::memcpy(&numEntries, data + 8, sizeof(numEntries));
+        std::memcpy(&manifestHash, data + 16, sizeof(manifestHash));
+    }
+    if (size < HEADER_SIZE || std::memcmp(data, MAGIC, sizeof(MAGIC)) != 0 || version != VERSION ||
+            size < HEADER_SIZE + (std::uint64_t)numEntries * sizeof(ResourceArchiveEntry)) {
+        std::cerr << "not a valid resource archive: " << filename << std::endl;
+        close();
+        return false;
+    }
+
+    // Index the entries, making sure that their data lies within the file, and that a texture's
+    // data holds all of its pixels, since they're read by its size rather than the entry's.
+    const ResourceArchiveEntry* entries = (const ResourceArchiveEntry*)(data + HEADER_SIZE);
+    for (std::uint32_t i = 0; i < numEntries; ++i) {
+
+        const ResourceArchiveEntry& entry = entries[i];
+        bool isValid = entry.id[sizeof(entry.id) - 1] == '\0' &&
+                entry.type <= ResourceArchiveEntry::FONT &&
+                entry.offset <= size && entry.size <= size - entry.offset &&
+                (entry.type != ResourceArchiveEntry::TEXTURE ||
+                entry.size == (std::uint64_t)entry.width * entry.height * 4);
+        if (!isValid) {
+            std::cerr << "corrupt entry in resource archive: " << filename << std::endl;
+            close();
+            return false;
+        }
+
+        _entries[entry.id] = &entry;
+    }
+
+    _manifestHash = manifestHash;
+    return true;
+}
+
+void ResourceArchive::close() {
+    _manifestHash = 0;
+    _entries.clear();
+    _file.close();
+}
+
+const ResourceArchiveEntry* ResourceArchive::find(const std::string& id,
+        const ResourceArchiveEntry::TYPE& type) const {
+
+    auto i = _entries.find(id);
+    if (i == _entries.end() || i->second->type != type)
+        return nullptr;
+    return i->second;
+}
@@ -0,0 +1,85 @@
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <iterator>
+
+#include <SFML/Graphics.hpp>
+
+#include "ResourceArchiveWriter.hpp"
+#include "ResourceArchive.hpp"
+
+void ResourceArchiveWriter::addTexture(const std::string& id, const sf::Image& image) {
+    addEntry(id, ResourceArchiveEntry::TEXTURE, image.getSize().x, image.getSize().y,
+            image.getPixelsPtr(), image.getSize().x * image.getSize().y * 4);
+}
+
+bool ResourceArchiveWriter::addFont(const std::string& id, const std::string& filename) {
+
+    std::ifstream file(filename, std::ios::binary);
+    if (!file)
+        return false;
+
+    std::vector<char> contents((std::istreambuf_iterator<char>(file)),
+            std::istreambuf_iterator<char>());
+    addEntry(id, ResourceArchiveEntry::FONT, 0, 0, contents.data(), contents.size());
+    return true;
+}
+
+bool ResourceArchiveWriter::write(const std::string& filename) const {
+
+    std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+    if (!file)
+        return false;
+
+    // lay out the data after the header and index, aligning each entry
+    std::vector<ResourceArchiveEntry> entries = _entries;
+    std::uint64_t offset = ResourceArchive::HEADER_SIZE +
+            entries.size() * sizeof(ResourceArchiveEntry);
+    for (ResourceArchiveEntry& entry : entries) {
+        offset = (offset + ResourceArchive::DATA_ALIGNMENT - 1) /
+                ResourceArchive::DATA_ALIGNMENT * ResourceArchive::DATA_ALIGNMENT;
+        entry.offset = offset;
+        offset += entry.size;
+    }
+
+    // write header and index
+    std::uint32_t header[4] = {0, ResourceArchive::VERSION, (std::uint32_t)entries.size(), 0};
+    std::memcpy(header, ResourceArchive::MAGIC, sizeof(ResourceArchive::MAGIC));
+    file.write((const char*)header, sizeof(header));
+    file.write((const char*)&_manifestHash, sizeof(_manifestHash));
+    file.write((const char*)entries.data(), entries.size() * sizeof(ResourceArchiveEntry));
+
+    // write data, padding up to each entry's offset
+    std::uint64_t position = ResourceArchive::HEADER_SIZE +
+            entries.size() * sizeof(ResourceArchiveEntry);
+    const char zeros[ResourceArchive::DATA_ALIGNMENT] = {};
+    for (std::size_t i = 0; i < entries.size(); ++i) {
+        file.write(zeros, entries[i].offset - position);
+        file.write(_data[i].data(), _data[i].size());
+        position = entries[i].offset + entries[i].size;
+    }
+
+    return (bool)file;
+}
+
+void ResourceArchiveWriter::addEntry(const std::string& id, const ResourceArchiveEntry::TYPE& type,
+        const unsigned int& width, const unsigned int& height, const void* data,
+        const std::size_t& size) {
+
+    ResourceArchiveEntry entry;
+    std::memset(&entry, 0, sizeof(entry));
+
+    // the id must fit with its null terminator
+    assert(id.size() < sizeof(entry.id));
+    std::strncpy(entry.id, id.c_str(), sizeof(entry.id) - 1);
+    entry.type = type;
+    entry.width = width;
+    entry.height = height;
+    entry.size = size;
+
+    _entries.push_back(entry);
+    _data.push_back(std::vector<char>((const char*)data, (const char*)data + size));
+}
@@ -5,7 +5,13 @@
 #include <string>
 #include <type_traits>
 #include <iostream>
-#include <math.h>
+#include <mutex>
+#include <condition_variable>
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <limits>
 
 #include <SFML/Graphics.hpp>
 #include <box2d/box2d.h>
@@ -17,514 +23,605 @@
 #include "Resources/SpriteResource.hpp"
 #include "Resources/FontResource.hpp"
 #include "Resources/PolygonResource.hpp"
+#include "WorkerPool.hpp"
+#include "ResourceArchive.hpp"
+#include "ResourceArchiveWriter.hpp"
+#include "ResourceManifest.hpp"
 
 ResourceCache::ResourceCache() :
-    _initialized(false)
+    _initialized(false),
+    _archiveWriter(nullptr),
+    _packSucceeded(true),
+    _lazyLoading(false),
+    _textureBudget(0),
+    _textureBytes(0),
+    _frame(0),
+    _numEvictions(0),
+    _frozen(false),
+    _numQueuedFiles(0),
+    _numLoaderThreads(0)
 {}
 
 ResourceCache::~ResourceCache() {
     // free memory owned by resources
-    for (auto i : _resources)
-        i.second.reset();
+    for (Slot& slot : _slots)
+        slot.resource.reset();
+}
+
+bool ResourceCache::openManifest(const std::string& filename) {
+    assert(!_initialized);
+    return _manifest.load(filename);
+}
+
+bool ResourceCache::openArchive(const std::string& filename) {
+
+    assert(!_initialized);
+    assert(_manifest.isLoaded());
+
+    if (!_archive.open(filename))
+        return false;
+
+    // Resources are found in the archive by id, so an archive packed from another manifest could
+    // have different files under the same ids.
+    if (_archive.getManifestHash() != _manifest.getArchiveHash()) {
+        std::cerr << "resource archive doesn't match the manifest, not using it: " << filename
+                << std::endl;
+        _archive.close();
+        return false;
+    }
+    return true;
+}
+
+void ResourceCache::setLazyLoading(const bool& lazy) {
+    assert(!_initialized);
+    _lazyLoading = lazy;
+}
+
+void ResourceCache::setTextureBudget(const std::size_t& bytes) {
+    _textureBudget = bytes;
+}
+
+void ResourceCache::setLoaderThreads(const unsigned& numThreads) {
+    assert(!_initialized);
+    _numLoaderThreads = numThreads;
+}
+
+bool ResourceCache::pack(ResourceArchiveWriter& writer) {
+
+    assert(!_initialized);
+
+    _archiveWriter = &writer;
+    _archiveWriter->setManifestHash(_manifest.getArchiveHash());
+    _packSucceeded = true;
+    loadAll();
+    _archiveWriter = nullptr;
+
+    return _packSucceeded;
 }
 
 void ResourceCache::init() {
 
+    startLoading();
+
+    // Let the workers decode everything in parallel, then upload all of the textures in one pass.
+    // Since nothing is left to decode, finishLoading() also shuts down the worker threads.
+    _loaderPool->wait();
+    finishLoading(std::numeric_limits<int>::max());
+}
+
+void ResourceCache::startLoading() {
+
+    assert(!_initialized);
     _initialized = true;
-    
-    // TEXTURES ////////////////////////////////////////////////////////////////////////////////////
-
-    loadTextureResource(
-        "BIRD_TEXTURE",
-        "../data/bird_texture.png"
-    );
-
-    loadTextureResource(
-        "TITLE_LOGO_TEXTURE",
-        "../data/GBLogoWarpedNoFill.png"
-    );
-
-    loadTextureResource(
-        "BEACH_BACKGROUND_TEXTURE",
-        "../data/beach-background-redone.png"
-    );
-
-    loadTextureResource(
-        "CIRCLE_INDICATOR_TEXTURE",
-        "../data/circle-indicator.png"
-    );
-
-    loadTextureResource(
-        "STREETLIGHT_TEXTURE",
-        "../data/streetlight_texture.png"
-    );
-
-    loadTextureResource(
-        "GROUND_TEXTURE",
-        "../data/simple-sand2.png"
-    );
-
-    loadTextureResource(
-        "NPC_MALE_TEXTURE",
-        "../data/NPC_man.png"
-    );
-
-    loadTextureResource(
-        "NPC_FEMALE_TEXTURE",
-        "../data/NPC_woman.png"
-    );
-
-    loadTextureResource(
-        "TREE_TEXTURE",
-        "../data/tree_texture.png"
-    );
-
-    loadTextureResource(
-        "CLOUD_TEXTURE",
-        "../data/cloud_texture.png"
-    );
-
-    loadTextureResource(
-        "POOP_TEXTURE",
-        "../data/poop_texture.png"
-    );
-
-    loadTextureResource(
-        "POOP_SPLATTER_TEXTURE",
-        "../data/poop_splatter_texture.png"
-    );
-
-    loadTextureResource(
-        "ROCK_TEXTURE",
-        "../data/rock.png"
-    );
-
-    loadTextureResource(
-        "LIFEGUARD_TEXTURE",
-        "../data/lifeguard.png"
-    );
-
-    loadTextureResource(
-        "DOCKS_TEXTURE",
-        "../data/docks.png"
-    );
-
-    loadTextureResource(
-        "UMBRELLA_STATIC_TEXTURE",
-        "../data/umbrella_static_texture.png"
-    );
-
-    // SPRITES /////////////////////////////////////////////
-
-    loadSpriteResource(
-        "BIRD_SPRITE",
-        *getResource<TextureResource>("BIRD_TEXTURE"),
-        {
-            { 0,  0, 16, 16}, //  0 dead
-            {16,  0, 16, 16}, //  1 standing -- tall
-            {32,  0, 16, 16}, //  2     medium height
-            {48,  0, 16, 16}, //  3     low
-            {64,  0, 16, 16}, //  4 pecking
-            { 0, 16, 16, 16}, //  5 flying mouth closed -- wings down
-            {16, 16, 16, 16}, //  6     wings down-middle
-            {32, 16, 16, 16}, //  7     wings middle
-            {48, 16, 16, 16}, //  8     wings up-middle
-            {64, 16, 16, 16}, //  9     wings up
-            { 0, 32, 16, 16}, // 10 flying mouth open -- wings down
-            {16, 32, 16, 16}, // 11     wings down-middle
-            {32, 32, 16, 16}, // 12     wings middle
-            {48, 32, 16, 16}, // 13     wings up-middle
-            {64, 32, 16, 16}  // 14     wings up
-        },
-        50.0f / 16 // scale so that the final width is 50 pixels
-    );
-
-    loadSpriteResource(
-        "BEACH_BACKGROUND_SPRITE",
-        *getResource<TextureResource>("BEACH_BACKGROUND_TEXTURE"),
-        {{0, 0, 200, 100}},
-        NATIVE_RESOLUTION.x / 200.0f
-    );
-
-    loadSpriteResource(
-        "TITLE_LOGO_SPRITE",
-        *getResource<TextureResource>("TITLE_LOGO_TEXTURE"),
-        {{0, 0, 216, 176}},
-        2.0f
-    );
-
-    loadSpriteResource(
-        "CIRCLE_INDICATOR_SPRITE",
-        *getResource<TextureResource>("CIRCLE_INDICATOR_TEXTURE"),
-        {
-            {0, 0, 8, 8}, // filled
-            {8, 0, 8, 8}  // empty
-        },
-        4.0f
-    );
-
-    loadSpriteResource(
-        "GROUND_SPRITE",
-        *getResource<TextureResource>("GROUND_TEXTURE"),
-        {{0, 0, 194, 32}},
-        2.0f
-    );
-
-    loadSpriteResource(
-        "BIG_GROUND_SPRITE",
-        *getResource<TextureResource>("BIRD_TEXTURE"),
-        {{1, 1, 1, 1}}, // grab a transparent section of the bird texture
-        1.0f
-    );
-
-    loadSpriteResource(
-        "STREETLIGHT_SPRITE",
-        *getResource<TextureResource>("STREETLIGHT_TEXTURE"),
-        {
-            {0, 16, 26, 7}, // base
-            {9,  9,  8, 7}, // shaft
-            {9,  0, 40, 9}  // tip ;)
-        },
-        3.5f
-    );
-
-    loadSpriteResource(
-        "POOP_SPRITE",
-        *getResource<TextureResource>("POOP_TEXTURE"),
-        {{0, 0, 31, 41}},
-        0.5f
-    );
-
-    loadSpriteResource(
-        "SPLATTER_SPRITE",
-        *getResource<TextureResource>("POOP_SPLATTER_TEXTURE"),
-        {{2, 12, 43, 9}},
-        0.75f
-    );
-
-    loadSpriteResource(
-        "NPC_MALE_SPRITE",
-        *getResource<TextureResource>("NPC_MALE_TEXTURE"),
-        {
-            { 0,   0, 32, 48}, // idle
-            {32,   0, 32, 48},
-            {64,   0, 32, 48},
-            {96,   0, 32, 48},
-            { 0,  48, 32, 48}, // walk
-            {32,  48, 32, 48},
-            {64,  48, 32, 48},
-            {96,  48, 32, 48},
-            { 0,  96, 32, 48},
-            {32,  96, 32, 48},
-            {64,  96, 32, 48}, // throw
-            {96,  96, 32, 48},
-            { 0, 144, 32, 48},
-            {32, 144, 32, 48},
-            {64, 144, 32, 48},
-            {96, 144, 32, 48},
-        },
-        3.5f
-    );
-
-    loadSpriteResource(
-        "NPC_FEMALE_SPRITE",
-        *getResource<TextureResource>("NPC_FEMALE_TEXTURE"),
-        getResource<SpriteResource>("NPC_MALE_SPRITE")->textureRects,
-        3.5f
-    );
-
-    loadSpriteResource(
-        "TREE_SPRITE",
-        *getResource<TextureResource>("TREE_TEXTURE"),
-        {
-            {38, 65, 25, 9},
-            {46, 49, 19, 12},
-            {3, 13, 72, 31}
-        },
-        4.0f
-    );
-
-    loadSpriteResource(
-        "CLOUD_SPRITE",
-        *getResource<TextureResource>("CLOUD_TEXTURE"),
-        {{3, 4, 27, 14}},
-        4.0f
-    );
-
-    loadSpriteResource(
-        "LIFEGUARD_SPRITE",
-        *getResource<TextureResource>("LIFEGUARD_TEXTURE"),
-        {{0, 0, 109, 56}},
-        2.0f
-    );
-
-    loadSpriteResource(
-        "DOCKS_SPRITE",
-        *getResource<TextureResource>("DOCKS_TEXTURE"),
-        {
-            {4, 6, 47, 20},
-            {58, 6, 44, 20},
-            {119, 6, 51, 20},
-            {4, 30, 47, 16},
-            {58, 30, 44, 16},
-            {119, 30, 48, 16}
-        },
-        2.0f
-    );
-
-    loadSpriteResource(
-        "ROCK_SPRITE", 
-        *getResource<TextureResource>("ROCK_TEXTURE"),
-        {{0, 0, 10, 10}},
-        2.0f
-    );
-
-    loadSpriteResource(
-        "UMBRELLA_SPRITE",
-        *getResource<TextureResource>("UMBRELLA_STATIC_TEXTURE"),
-        {{1, 1, 59, 65}},
-        2.0f
-    );
-    // FONTS ///////////////////////////////////////////////
-
-    loadFontResource("ARCADE_FONT", "../data/ARCADECLASSIC.ttf");
-
-    loadFontResource("JOYSTIX_FONT", "../data/joystix.monospace.ttf");
-
-    // POLYGONS ////////////////////////////////////////////////////////////////////////////////////
-
-    // this hitbox will always encompass the full texture recangle in a rectangle shape
-    loadPolygonResource(
-        "FULL_HITBOX",
-        {
-            { 0.5f,  0.5f},
-            {-0.5f,  0.5f},
-            {-0.5f, -0.5f},
-            { 0.5f, -0.5f}
-        }
-    );
 
-    // this hitbox always encompasses the full texture rectangle in an octagon
-    loadPolygonResource(
-        "OCTAGON_HITBOX",
-        {
-            {0.5f * cosf(0.0f *  PI), 0.5f * sinf(0.0f *  PI)},
-            {0.5f * cosf(0.25f * PI), 0.5f * sinf(0.25f * PI)},
-            {0.5f * cosf(0.5f *  PI), 0.5f * sinf(0.5f *  PI)},
-            {0.5f * cosf(0.75f * PI), 0.5f * sinf(0.75f * PI)},
-            {0.5f * cosf(1.0f *  PI), 0.5f * sinf(1.0f *  PI)},
-            {0.5f * cosf(1.25f * PI), 0.5f * sinf(1.25f * PI)},
-            {0.5f * cosf(1.5f *  PI), 0.5f * sinf(1.5f *  PI)},
-            {0.5f * cosf(1.75f * PI), 0.5f * sinf(1.75f * PI)}
-        }
-    );
+    // start the threads which decode files, then queue everything up
+    _loaderPool.reset(new WorkerPool(_numLoaderThreads));
+    loadAll();
+}
 
-    loadPolygonResource(
-        "SLANTED_HITBOX",
-        {
-            {0.5f, 0.5f},
-            {0.1f, -0.5f},
-            {-0.5f, -0.5f},
-            {-0.1f, 0.5f}
-        }
-    );
+bool ResourceCache::finishLoading(const int& maxTextureUploads) {
 
-    loadPolygonResource(
-        "CLOUD_HITBOX",
-        {
-            {0.26f, 0.26f},
-            {0.06f, 0.23f},
-            {-0.28f, -0.01f},
-            {-0.45f, -0.5f},
-            {0.45f, -0.5f}
-        }
-    );
+    assert(_initialized);
 
-    loadPolygonResource(
-        "LIFEGUARD_RAMP_HITBOX",
-        {
-            {(106 + 0.5f) / 109.0f - 0.5f, (57 + 0.5f) / -56.0f + 0.5f},
-            {( 59 + 0.5f) / 109.0f - 0.5f, (36 + 0.5f) / -56.0f + 0.5f},
-            {( 59 + 0.5f) / 109.0f - 0.5f, (39 + 0.5f) / -56.0f + 0.5f},
-            {(100 + 0.5f) / 109.0f - 0.5f, (57 + 0.5f) / -56.0f + 0.5f}
-        }
-    );
+    // collect the files which have been decoded, but only up to the allowed amount of textures
+    std::vector<std::shared_ptr<PendingFile>> decodedFiles;
+    {
+        std::lock_guard<std::mutex> lock(_loadingMutex);
 
-    loadPolygonResource(
-        "LIFEGUARD_PLATFORM_HITBOX",
-        {
-            {(59 + 0.5f) / 109.0f - 0.5f, (36 + 0.5f) / -56.0f + 0.5f},
-            {( 6 + 0.5f) / 109.0f - 0.5f, (36 + 0.5f) / -56.0f + 0.5f},
-            {( 6 + 0.5f) / 109.0f - 0.5f, (39 + 0.5f) / -56.0f + 0.5f},
-            {(59 + 0.5f) / 109.0f - 0.5f, (39 + 0.5f) / -56.0f + 0.5f}
-        }
-    );
+        int numTextures = 0;
+        for (auto i = _pendingFiles.begin(); i != _pendingFiles.end();) {
 
-    loadPolygonResource(
-        "LIFEGUARD_BUILDING_HITBOX",
-        {
-            {(50 + 0.5f) / 109.0f - 0.5f, ( 0 + 0.5f) / -56.0f + 0.5f},
-            {( 6 + 0.5f) / 109.0f - 0.5f, ( 0 + 0.5f) / -56.0f + 0.5f},
-            {( 6 + 0.5f) / 109.0f - 0.5f, (36 + 0.5f) / -56.0f + 0.5f},
-            {(41 + 0.5f) / 109.0f - 0.5f, (36 + 0.5f) / -56.0f + 0.5f}
-        }
-    );
+            bool isTexture = _slots[(*i)->slot].type == TextureResource::TYPE;
+            if (!(*i)->decoded || (isTexture && numTextures >= maxTextureUploads)) {
+                ++i;
+                continue;
+            }
 
-    loadPolygonResource(
-        "TREETOP_HITBOX",
-        {
-            { 0.28f,  0.40f},
-            {-0.25f,  0.5f},
-            {-0.5f, 0.25f},
-            {-0.5f, -0.25f},
-            {-0.25f, -0.5f},
-            { 0.40f, -0.5f},
-            { 0.5f, 0.0f}
+            if (isTexture)
+                ++numTextures;
+            decodedFiles.push_back(*i);
+            i = _pendingFiles.erase(i);
         }
-    );
+    }
 
-    loadPolygonResource(
-        "UMBRELLA_HITBOX",
-        {
-            { 0.36f, 0.3f},
-            { 0.0f, 0.43f},
-            { -0.36f, 0.3f},
-            {-0.5f, 0.13f},
-            { 0.5f, 0.13f}
-        }
-    );
+    // store them as resources outside of the lock, since uploading textures takes a while
+    for (auto& pendingFile : decodedFiles)
+        finishPendingFile(*pendingFile);
 
-    loadPolygonResource(
-        "BIRD_HITBOX",
-        {
-            { 7.5f / 16,  0.5f / 16},
-            { 4.5f / 16,  3.5f / 16},
-            { 1.5f / 16,  3.5f / 16},
-            {-7.5f / 16, -0.5f / 16},
-            {-7.5f / 16, -1.5f / 16},
-            {-4.5f / 16, -3.5f / 16},
-            { 1.5f / 16, -3.5f / 16}
-        }
-    );
+    // once everything is loaded, the worker threads aren't needed anymore
+    bool isDone = _pendingFiles.empty();
+    if (isDone)
+        _loaderPool.reset();
 
-    loadPolygonResource(
-        "SPLATTER_HITBOX",
-        {
-            { 0.4f,  0.5f},
-            {-0.4f,  0.5f},
-            {-0.5f,  0.0f},
-            {-0.4f, -0.5f},
-            { 0.4f, -0.5f},
-            { 0.5f,  0.0f},
-        }
-    );
+    return isDone;
+}
 
-    loadPolygonResource(
-        "NPC_HITBOX_BODY",
-        {
-            { 5.5f / 32, -23.5f / 48},
-            { 5.5f / 32,   3.5f / 48},
-            { 3.5f / 32,   7.5f / 48},
-            {-3.5f / 32,   7.5f / 48},
-            {-5.5f / 32,   3.5f / 48},
-            {-5.5f / 32, -23.5f / 48},
-        }
-    );
+float ResourceCache::getLoadingProgress() const {
+    assert(_initialized);
+    return _numQueuedFiles == 0 ? 1.0f :
+            1.0f - (float)_pendingFiles.size() / _numQueuedFiles;
+}
 
-    loadPolygonResource(
-        "STREETLIGHT_BASE_HITBOX",
-        {
-            {  4.5f / 26,  3.0f / 7},
-            {- 4.5f / 26,  3.0f / 7},
-            {-12.5f / 26, -3.0f / 7},
-            { 12.5f / 26, -3.0f / 7}
-        }
-    );
+bool ResourceCache::isLoaded(const ResourceId& id) const {
 
-    loadPolygonResource(
-        "STREETLIGHT_TOP_HITBOX_1",
-        {
-            {-12.5f / 40,  4.0f / 9},
-            {-17.5f / 40,  4.0f / 9},
-            {-19.5f / 40,  2.0f / 9},
-            {-19.5f / 40, -4.0f / 9},
-            {-12.5f / 40, -4.0f / 9}
-        }
-    );
+    assert(_initialized);
 
-    loadPolygonResource(
-        "STREETLIGHT_TOP_HITBOX_2",
-        {
-            { 17.5f / 40,  0.0f / 9},
-            {  5.5f / 40,  4.0f / 9},
-            {-12.5f / 40,  4.0f / 9},
-            {-12.5f / 40, -1.0f / 9},
-            {  3.5f / 40, -1.0f / 9}
+    auto i = _slotIndices.find(id);
+    assert(i != _slotIndices.end());
+    return (bool)_slots[i->second].resource;
+}
+
+void ResourceCache::collectGarbage() {
+
+    assert(_initialized);
+
+    if (_frozen)
+        return;
+
+    ++_frame;
+
+    if (_textureBudget == 0 || _textureBytes <= _textureBudget)
+        return;
+
+    // Find the textures which nobody holds onto. A texture is only referenced by the cache and by
+    // its own sprites, and its sprites are only referenced by the cache.
+    std::vector<int> candidates;
+    for (int i = 0; i < (int)_slots.size(); ++i) {
+
+        if (_slots[i].type != TextureResource::TYPE || !_slots[i].resource)
+            continue;
+
+        long numReferences = 1;
+        bool isSpriteHeld = false;
+        for (const Slot& slot : _slots) {
+            if (slot.type == SpriteResource::TYPE && slot.textureSlot == i && slot.resource) {
+                ++numReferences;
+                isSpriteHeld |= slot.resource.use_count() > 1;
+            }
         }
-    );
 
-    loadPolygonResource(
-        "STREETLIGHT_TOP_HITBOX_3",
-        {
-            {17.5f / 40,  0.0f / 9},
-            { 3.5f / 40, -1.0f / 9},
-            { 3.5f / 40, -4.0f / 9},
-            {19.5f / 40, -4.0f / 9},
-            {19.5f / 40, -2.0f / 9}
+        if (!isSpriteHeld && _slots[i].resource.use_count() == numReferences)
+            candidates.push_back(i);
+    }
+
+    // evict the least recently used ones first, until the textures fit in the budget
+    std::sort(candidates.begin(), candidates.end(), [this](const int& a, const int& b) {
+        return _slots[a].lastUsedFrame < _slots[b].lastUsedFrame;
+    });
+    for (int i : candidates) {
+
+        if (_textureBytes <= _textureBudget)
+            break;
+
+        for (Slot& slot : _slots) {
+            if (slot.type == SpriteResource::TYPE && slot.textureSlot == i)
+                slot.resource.reset();
         }
-    );
+        _slots[i].resource.reset();
+        _textureBytes -= _slots[i].gpuBytes;
+        ++_numEvictions;
+    }
+}
+
+const ResourceCache& ResourceCache::freeze() {
+
+    assert(_initialized);
+    assert(_pendingFiles.empty());
+
+    // load whatever was left for lazy loading or was evicted
+    for (int i = 0; i < (int)_slots.size(); ++i)
+        loadNow(i);
+
+    _frozen = true;
+    return *this;
+}
+
+std::size_t ResourceCache::getCpuBytes() const {
+    std::size_t bytes = 0;
+    for (const Slot& slot : _slots) {
+        if (slot.resource)
+            bytes += slot.cpuBytes;
+    }
+    return bytes;
+}
+
+std::size_t ResourceCache::getGpuBytes() const {
+    std::size_t bytes = 0;
+    for (const Slot& slot : _slots) {
+        if (slot.resource)
+            bytes += slot.gpuBytes;
+    }
+    return bytes;
+}
+
+void ResourceCache::printStats(std::ostream& out) const {
+
+    std::ios::fmtflags flags = out.flags();
+    std::streamsize precision = out.precision();
+
+    out << "Resources:" << std::endl;
+    out << std::left << std::setw(28) << "  id" << std::right
+        << std::setw(10) << "type"
+        << std::setw(12) << "cpu bytes"
+        << std::setw(12) << "gpu bytes"
+        << std::setw(12) << "load (ms)"
+        << std::setw(8) << "loads"
+        << std::setw(10) << "loaded" << std::endl;
+
+    float totalLoadTime = 0.0f;
+    for (const Slot& slot : _slots) {
+
+        const char* typeName =
+                slot.type == TextureResource::TYPE ? "texture" :
+                slot.type == SpriteResource::TYPE ? "sprite" :
+                slot.type == FontResource::TYPE ? "font" :
+                slot.type == PolygonResource::TYPE ? "polygon" : "unknown";
+
+        out << std::left << std::setw(28) << ("  " + slot.id) << std::right
+            << std::setw(10) << typeName
+            << std::setw(12) << slot.cpuBytes
+            << std::setw(12) << slot.gpuBytes
+            << std::setw(12) << std::fixed << std::setprecision(3) << slot.loadTime * 1000.0f
+            << std::setw(8) << slot.numLoads
+            << std::setw(10) << (slot.resource ? "yes" : "no") << std::endl;
+
+        totalLoadTime += slot.loadTime;
+    }
+
+    out << "  loaded: " << getCpuBytes() << " cpu bytes, " << getGpuBytes()
+        << " gpu bytes (texture budget: ";
+    if (_textureBudget == 0)
+        out << "none";
+    else
+        out << _textureBudget << " bytes";
+    out << ")" << std::endl;
+    out << "  evictions: " << _numEvictions << ", time spent loading: " << totalLoadTime * 1000.0f
+        << " ms" << std::endl;
+
+    out.flags(flags);
+    out.precision(precision);
+}
+
+int ResourceCache::addSlot(const std::string& id, const ResourceType& type) {
+
+    // make sure a resource with the id (or its hash) doesn't already exist
+    assert(_slotIndices.find(id) == _slotIndices.end());
+
+    Slot slot;
+    slot.id = id;
+    slot.type = type;
+    slot.textureSlot = -1;
+    slot.scaleFactor = 1.0f;
+    slot.cpuBytes = 0;
+    slot.gpuBytes = 0;
+    slot.loadTime = 0.0f;
+    slot.numLoads = 0;
+    slot.lastUsedFrame = _frame;
+
+    _slotIndices[id] = _slots.size();
+    _slots.push_back(slot);
+    return _slots.size() - 1;
+}
+
+void ResourceCache::storeResource(const int& slot, const std::shared_ptr<Resource>& resource,
+        const float& loadTime) {
+
+    Slot& s = _slots[slot];
+    assert(!s.resource);
+    assert(s.type == resource->getType());
+
+    s.resource = resource;
+    s.cpuBytes = resource->getCpuBytes();
+    s.gpuBytes = resource->getGpuBytes();
+    s.loadTime = loadTime;
+    ++s.numLoads;
+    s.lastUsedFrame = _frame;
+
+    if (s.type == TextureResource::TYPE)
+        _textureBytes += s.gpuBytes;
+}
+
+void ResourceCache::useSlot(const int& slot) {
+
+    assert(_initialized);
+
+    // A frozen cache has everything loaded, and must not be written to since other threads may be
+    // reading it. Only eviction cares about when a slot was last used, and that never happens.
+    if (_frozen) {
+        assert(_slots[slot].resource);
+        return;
+    }
+
+    Slot& s = _slots[slot];
+    if (!s.resource)
+        loadNow(slot);
+
+    // using a sprite also counts as using its texture
+    s.lastUsedFrame = _frame;
+    if (s.textureSlot >= 0)
+        _slots[s.textureSlot].lastUsedFrame = _frame;
+}
+
+void ResourceCache::loadAll() {
+
+    assert(_manifest.isLoaded());
+
+    // the manifest lists textures before sprites, so every sprite's texture already has a slot
+    for (const ResourceManifest::Texture& texture : _manifest.textures)
+        loadTextureResource(texture.id, texture.filename);
+
+    for (const ResourceManifest::Sprite& sprite : _manifest.sprites)
+        loadSpriteResource(sprite.id, sprite.textureId, sprite.frames, sprite.scaleFactor);
+
+    for (const ResourceManifest::Font& font : _manifest.fonts)
+        loadFontResource(font.id, font.filename, font.characterSizes);
+
+    for (const ResourceManifest::Polygon& polygon : _manifest.polygons)
+        loadPolygonResource(polygon.id, polygon.shape);
 }
 
 void ResourceCache::loadTextureResource(const std::string& id, const std::string& filename) {
 
-    // load the texture from the file
-    sf::Texture texture;
-    texture.loadFromFile(filename);
+    // when packing, decode the image right away and hand it to the writer
+    if (_archiveWriter) {
+        sf::Image image;
+        if (image.loadFromFile(filename))
+            _archiveWriter->addTexture(id, image);
+        else
+            _packSucceeded = false;
+        return;
+    }
+
+    int slot = addSlot(id, TextureResource::TYPE);
+    _slots[slot].filename = filename;
+
+    // when loading lazily, the texture gets loaded once it's first used
+    if (!_lazyLoading)
+        queueTexture(slot);
+}
 
-    // make sure a resource with the id does not already exist, then make the resource
-    assert(_resources.find(id) == _resources.end());
-    _resources[id] = std::make_shared<TextureResource>(texture);
+void ResourceCache::queueTexture(const int& slot) {
+
+    std::shared_ptr<PendingFile> pendingFile = std::make_shared<PendingFile>();
+    pendingFile->slot = slot;
+    pendingFile->decoded = false;
+    pendingFile->decodeTime = 0.0f;
+    pendingFile->pixels = nullptr;
+    _pendingFiles.push_back(pendingFile);
+    ++_numQueuedFiles;
+
+    // if the archive has the texture, then its pixels are already decoded
+    const ResourceArchiveEntry* entry =
+            _archive.find(_slots[slot].id, ResourceArchiveEntry::TEXTURE);
+    if (entry) {
+        pendingFile->decoded = true;
+        pendingFile->pixels = _archive.getData(*entry);
+        pendingFile->pixelsSize = sf::Vector2u(entry->width, entry->height);
+        return;
+    }
+
+    // Decode the image on a worker thread, right into the pending file since images can't be moved.
+    // The worker only touches the image until it marks the file as decoded (under the lock); after
+    // that, only the main thread touches it.
+    std::string filename = _slots[slot].filename;
+    _loaderPool->push([this, pendingFile, filename]() {
+        auto start = std::chrono::steady_clock::now();
+        pendingFile->image.loadFromFile(filename);
+        std::chrono::duration<float> decodeTime = std::chrono::steady_clock::now() - start;
+
+        std::lock_guard<std::mutex> lock(_loadingMutex);
+        pendingFile->decodeTime = decodeTime.count();
+        pendingFile->decoded = true;
+        _loadingCondition.notify_all();
+    });
 }
 
-void ResourceCache::loadSpriteResource(const std::string& id,
-        const TextureResource& textureResource, const std::vector<sf::IntRect>& textureRects,
-        const float& scaleFactor) {
+void ResourceCache::loadSpriteResource(const std::string& id, const std::string& textureId,
+        const std::vector<sf::IntRect>& textureRects, const float& scaleFactor) {
 
-    // create underlying sprite
-    sf::Sprite sprite;
-    sprite.setTexture(textureResource.texture);
+    // sprites are only frames of a texture, which is packed on its own
+    if (_archiveWriter)
+        return;
 
-    // Make sure that there is at least one rectangle in textureRects, and set the sprite's
-    // texture rectangle to the first one.
+    // make sure that there is at least one rectangle in textureRects
     assert(textureRects.size() > 0);
-    sprite.setTextureRect(textureRects.at(0));
-    // sprite.setOrigin(textureRects.at(0).width/2.0f, textureRects.at(0).height/2.0f);
-    // make sure a resource with the id does not already exist, then make the resource
-    assert(_resources.find(id) == _resources.end());
-    _resources[id] = std::make_shared<SpriteResource>(sprite, textureRects, scaleFactor);
+
+    // the sprite gets made once its texture has been loaded
+    int slot = addSlot(id, SpriteResource::TYPE);
+    _slots[slot].textureSlot = _slotIndices.at(textureId);
+    _slots[slot].textureRects = textureRects;
+    _slots[slot].scaleFactor = scaleFactor;
+}
+
+void ResourceCache::loadFontResource(const std::string& id, const std::string& filename,
+        const std::vector<unsigned int>& characterSizes) {
+
+    if (_archiveWriter) {
+        if (!_archiveWriter->addFont(id, filename))
+            _packSucceeded = false;
+        return;
+    }
+
+    int slot = addSlot(id, FontResource::TYPE);
+    _slots[slot].filename = filename;
+    _slots[slot].characterSizes = characterSizes;
+
+    // If the archive has the font, then load it straight from the mapped memory. SFML reads the
+    // font from that memory for as long as the font is used, which is fine since the archive stays
+    // mapped. Opening a font from memory is cheap, so no need for a worker.
+    const ResourceArchiveEntry* entry = _archive.find(id, ResourceArchiveEntry::FONT);
+    if (entry) {
+        auto start = std::chrono::steady_clock::now();
+        std::shared_ptr<FontResource> font =
+                std::make_shared<FontResource>(_archive.getData(*entry), entry->size);
+        font->renderGlyphs(characterSizes);
+        std::chrono::duration<float> loadTime = std::chrono::steady_clock::now() - start;
+        storeResource(slot, font, loadTime.count());
+        return;
+    }
+
+    std::shared_ptr<PendingFile> pendingFile = std::make_shared<PendingFile>();
+    pendingFile->slot = slot;
+    pendingFile->decoded = false;
+    pendingFile->decodeTime = 0.0f;
+    pendingFile->pixels = nullptr;
+    _pendingFiles.push_back(pendingFile);
+    ++_numQueuedFiles;
+
+    // fonts don't need the OpenGL context until glyphs are rendered, so load them on a worker
+    _loaderPool->push([this, pendingFile, filename]() {
+        auto start = std::chrono::steady_clock::now();
+        std::shared_ptr<FontResource> font =
+                std::make_shared<FontResource>(filename, getFileSize(filename));
+        std::chrono::duration<float> decodeTime = std::chrono::steady_clock::now() - start;
+
+        std::lock_guard<std::mutex> lock(_loadingMutex);
+        pendingFile->font = font;
+        pendingFile->decodeTime = decodeTime.count();
+        pendingFile->decoded = true;
+        _loadingCondition.notify_all();
+    });
 }
 
-void ResourceCache::loadFontResource(const std::string& id, const std::string& filename) {
-    sf::Font font;
+void ResourceCache::loadPolygonResource(const std::string& id, const b2PolygonShape& polygon) {
+
+    // polygons are part of the manifest, so there's nothing to pack
+    if (_archiveWriter)
+        return;
 
-    font.loadFromFile(filename);
+    // the manifest already made the convex hull, so the polygon is ready to use as it is
+    auto start = std::chrono::steady_clock::now();
+    std::shared_ptr<PolygonResource> resource = std::make_shared<PolygonResource>(polygon);
+    std::chrono::duration<float> loadTime = std::chrono::steady_clock::now() - start;
+
+    int slot = addSlot(id, PolygonResource::TYPE);
+    storeResource(slot, resource, loadTime.count());
+}
 
-    assert(_resources.find(id) == _resources.end());
-    _resources[id] = std::make_shared<FontResource>(font);
+void ResourceCache::finishPendingFile(const PendingFile& pendingFile) {
+
+    const Slot& slot = _slots[pendingFile.slot];
+
+    // the font was opened by a worker, but its glyphs are uploaded into textures, so they're
+    // rendered here
+    if (slot.type == FontResource::TYPE) {
+        auto start = std::chrono::steady_clock::now();
+        pendingFile.font->renderGlyphs(slot.characterSizes);
+        std::chrono::duration<float> renderTime = std::chrono::steady_clock::now() - start;
+        storeResource(pendingFile.slot, pendingFile.font,
+                pendingFile.decodeTime + renderTime.count());
+        return;
+    }
+
+    // Upload the decoded image right into the resource. Pixels from the archive are uploaded
+    // straight from the mapped memory, without copying them into an image first.
+    auto start = std::chrono::steady_clock::now();
+    std::shared_ptr<TextureResource> texture = pendingFile.pixels ?
+            std::make_shared<TextureResource>(pendingFile.pixels, pendingFile.pixelsSize) :
+            std::make_shared<TextureResource>(pendingFile.image);
+    std::chrono::duration<float> uploadTime = std::chrono::steady_clock::now() - start;
+
+    storeResource(pendingFile.slot, texture, pendingFile.decodeTime + uploadTime.count());
+
+    // make all the sprites which use this texture
+    for (int i = 0; i < (int)_slots.size(); ++i) {
+        if (_slots[i].textureSlot == pendingFile.slot && !_slots[i].resource)
+            makeSprite(i);
+    }
 }
 
-void ResourceCache::loadPolygonResource(const std::string& id,
-        const std::vector<b2Vec2>& vertices) {
+void ResourceCache::loadNow(const int& slot) {
+
+    Slot& s = _slots[slot];
+    if (s.resource)
+        return;
+
+    // sprites just need their texture, which makes the sprite as well
+    if (s.type == SpriteResource::TYPE) {
+        loadNow(s.textureSlot);
+        if (!s.resource)
+            makeSprite(slot);
+        return;
+    }
+
+    // only textures and fonts are ever not loaded
+    assert(s.type == TextureResource::TYPE || s.type == FontResource::TYPE);
+
+    // if the file is queued, then wait for it to be decoded and take it out of the queue
+    auto i = _pendingFiles.begin();
+    while (i != _pendingFiles.end() && (*i)->slot != slot)
+        ++i;
 
-    // make sure there are at least 3 vertices, then make the polygon shape
-    assert(vertices.size() >= 3);
-    b2PolygonShape polygon;
-    polygon.Set(vertices.data(), vertices.size());
+    if (i != _pendingFiles.end()) {
 
-    // make sure that the polygon is convex
-    assert(polygon.Validate());
+        std::shared_ptr<PendingFile> pendingFile = *i;
+        {
+            std::unique_lock<std::mutex> lock(_loadingMutex);
+            _loadingCondition.wait(lock, [&pendingFile]() { return pendingFile->decoded; });
+            _pendingFiles.erase(i);
+        }
+        finishPendingFile(*pendingFile);
+        return;
+    }
+
+    // Otherwise it's a texture that's loaded lazily, or that was evicted, so load it on the spot
+    // from the archive or its file.
+    assert(s.type == TextureResource::TYPE);
+
+    PendingFile pendingFile;
+    pendingFile.slot = slot;
+    pendingFile.decoded = true;
+    pendingFile.pixels = nullptr;
+
+    auto start = std::chrono::steady_clock::now();
+    const ResourceArchiveEntry* entry = _archive.find(s.id, ResourceArchiveEntry::TEXTURE);
+    if (entry) {
+        pendingFile.pixels = _archive.getData(*entry);
+        pendingFile.pixelsSize = sf::Vector2u(entry->width, entry->height);
+    } else {
+        pendingFile.image.loadFromFile(s.filename);
+    }
+    std::chrono::duration<float> decodeTime = std::chrono::steady_clock::now() - start;
+    pendingFile.decodeTime = decodeTime.count();
+
+    finishPendingFile(pendingFile);
+}
+
+void ResourceCache::makeSprite(const int& slot) {
+
+    const Slot& s = _slots[slot];
+    std::shared_ptr<const TextureResource> texture =
+            std::static_pointer_cast<const TextureResource>(_slots[s.textureSlot].resource);
+    assert(texture);
+
+    auto start = std::chrono::steady_clock::now();
+    std::shared_ptr<SpriteResource> sprite =
+            std::make_shared<SpriteResource>(texture, s.textureRects, s.scaleFactor);
+    std::chrono::duration<float> loadTime = std::chrono::steady_clock::now() - start;
+    storeResource(slot, sprite, loadTime.count());
+}
 
-    // make sure a resource with the id doesn't already exist, then make the resource
-    assert(_resources.find(id) == _resources.end());
-    _resources[id] = std::make_shared<PolygonResource>(polygon);
+std::size_t ResourceCache::getFileSize(const std::string& filename) {
+    std::ifstream file(filename, std::ios::binary | std::ios::ate);
+    return file ? (std::size_t)file.tellg() : 0;
 }
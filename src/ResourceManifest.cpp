@@ -0,0 +1,488 @@
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <sstream>
+#include <iostream>
+#include <iterator>
+#include <algorithm>
+#include <unordered_set>
+#include <unordered_map>
+
+#include <SFML/Graphics.hpp>
+#include <box2d/box2d.h>
+
+#include "ResourceManifest.hpp"
+#include "Utils.hpp"
+
+const char ResourceManifest::MAGIC[4] = {'G', 'B', 'R', 'M'};
+
+namespace {
+
+// Helpers for reading and writing the binary form. Everything is stored in the native byte order,
+// since the binary manifest is built alongside the game.
+
+template <typename T>
+void writeValue(std::ofstream& file, const T& value) {
+    file.write((const char*)&value, sizeof(T));
+}
+
+void writeString(std::ofstream& file, const std::string& s) {
+    writeValue(file, (std::uint32_t)s.size());
+    file.write(s.data(), s.size());
+}
+
+/**
+ * Reads values one after the other from the contents of a binary manifest. Once a read goes past
+ * the end, every read after it fails too.
+ */
+class BinaryReader {
+
+public:
+
+    BinaryReader(const std::string& contents) : _contents(contents), _position(0), _ok(true) {}
+
+    template <typename T>
+    T read() {
+        T value = T();
+        if (_ok && _position + sizeof(T) <= _contents.size()) {
+            std::memcpy(&value, _contents.data() + _position, sizeof(T));
+            _position += sizeof(T);
+        } else {
+            _ok = false;
+        }
+        return value;
+    }
+
+    std::string readString() {
+        std::uint32_t size = read<std::uint32_t>();
+        if (!_ok || _position + size > _contents.size()) {
+            _ok = false;
+            return "";
+        }
+        std::string s = _contents.substr(_position, size);
+        _position += size;
+        return s;
+    }
+
+    bool isOk() const { return _ok; }
+
+    bool isAtEnd() const { return _position == _contents.size(); }
+
+private:
+
+    const std::string& _contents;
+    std::size_t _position;
+    bool _ok;
+};
+
+// adds the given string to a 64-bit FNV-1a hash, including its terminator so that e.g. "ab", "c"
+// and "a", "bc" hash differently
+std::uint64_t hashString(std::uint64_t h, const std::string& s) {
+    for (const char& c : s)
+        h = (h ^ (unsigned char)c) * 1099511628211ull;
+    return h * 1099511628211ull;
+}
+
+} // namespace
+
+ResourceManifest::ResourceManifest() :
+    _loaded(false)
+{}
+
+bool ResourceManifest::load(const std::string& filename) {
+
+    clear();
+
+    std::ifstream file(filename, std::ios::binary);
+    if (!file) {
+        std::cerr << "unable to open resource manifest: " << filename << std::endl;
+        return false;
+    }
+    std::string contents((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    // binary manifests start with the magic, text ones can't
+    if (contents.size() >= sizeof(MAGIC) && std::memcmp(contents.data(), MAGIC, sizeof(MAGIC)) == 0)
+        _loaded = parseBinary(contents, filename);
+    else
+        _loaded = parseText(contents, filename);
+
+    if (!_loaded)
+        clear();
+    return _loaded;
+}
+
+std::uint64_t ResourceManifest::getArchiveHash() const {
+
+    assert(_loaded);
+
+    std::uint64_t h = 14695981039346656037ull;
+    for (const Texture& texture : textures)
+        h = hashString(hashString(h, texture.id), texture.filename);
+    for (const Font& font : fonts)
+        h = hashString(hashString(h, font.id), font.filename);
+    return h;
+}
+
+bool ResourceManifest::save(const std::string& filename) const {
+
+    assert(_loaded);
+
+    std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+    if (!file)
+        return false;
+
+    std::uint32_t version = VERSION;
+    file.write(MAGIC, sizeof(MAGIC));
+    writeValue(file, version);
+    writeValue(file, (std::uint32_t)textures.size());
+    writeValue(file, (std::uint32_t)sprites.size());
+    writeValue(file, (std::uint32_t)fonts.size());
+    writeValue(file, (std::uint32_t)polygons.size());
+
+    for (const Texture& texture : textures) {
+        writeString(file, texture.id);
+        writeString(file, texture.filename);
+    }
+
+    for (const Sprite& sprite : sprites) {
+        writeString(file, sprite.id);
+        writeString(file, sprite.textureId);
+        writeValue(file, sprite.scaleFactor);
+        writeValue(file, (std::uint32_t)sprite.frames.size());
+        for (const sf::IntRect& frame : sprite.frames) {
+            writeValue(file, (std::int32_t)frame.left);
+            writeValue(file, (std::int32_t)frame.top);
+            writeValue(file, (std::int32_t)frame.width);
+            writeValue(file, (std::int32_t)frame.height);
+        }
+    }
+
+    for (const Font& font : fonts) {
+        writeString(file, font.id);
+        writeString(file, font.filename);
+        writeValue(file, (std::uint32_t)font.characterSizes.size());
+        for (unsigned int characterSize : font.characterSizes)
+            writeValue(file, (std::uint32_t)characterSize);
+    }
+
+    // store the finished shape, so that the hull doesn't have to be computed again
+    for (const Polygon& polygon : polygons) {
+        const b2PolygonShape& shape = polygon.shape;
+        writeString(file, polygon.id);
+        writeValue(file, (std::int32_t)shape.m_count);
+        writeValue(file, shape.m_radius);
+        writeValue(file, shape.m_centroid.x);
+        writeValue(file, shape.m_centroid.y);
+        for (int i = 0; i < shape.m_count; ++i) {
+            writeValue(file, shape.m_vertices[i].x);
+            writeValue(file, shape.m_vertices[i].y);
+            writeValue(file, shape.m_normals[i].x);
+            writeValue(file, shape.m_normals[i].y);
+        }
+    }
+
+    return (bool)file;
+}
+
+bool ResourceManifest::parseText(const std::string& contents, const std::string& filename) {
+
+    std::unordered_set<std::string> ids;
+    std::unordered_set<std::string> textureIds;
+
+    // vertices of the polygon currently being read, its hull is made once all vertices are read
+    std::vector<b2Vec2> vertices;
+    bool isReadingPolygon = false;
+    bool isReadingSprite = false;
+    bool isReadingFont = false;
+    bool isTraced = false; // if the polygon being read was traced
+
+    // images of traced sprites, so that each is only decoded once
+    std::unordered_map<std::string, sf::Image> images;
+
+    std::istringstream lines(contents);
+    std::string line;
+    int lineNumber = 0;
+
+    // prints an error with the current line number, then evaluates to false
+    auto error = [&](const std::string& message) {
+        std::cerr << filename << ":" << lineNumber << ": " << message << std::endl;
+        return false;
+    };
+
+    // makes the shape of the polygon that was just read, and makes sure it's a valid convex hull
+    auto finishPolygon = [&]() {
+        isReadingPolygon = false;
+        if (vertices.size() < 3 || vertices.size() > b2_maxPolygonVertices)
+            return error("polygon " + polygons.back().id + " must have between 3 and " +
+                    std::to_string(b2_maxPolygonVertices) + " vertices");
+
+        // Every vertex must turn left, i.e. the vertices go counter-clockwise around a strictly
+        // convex hull. Set() would quietly reorder or drop vertices otherwise, so the hitbox
+        // wouldn't be what's written in the manifest.
+        for (std::size_t i = 0; i < vertices.size(); ++i) {
+            const b2Vec2& a = vertices[i];
+            const b2Vec2& b = vertices[(i + 1) % vertices.size()];
+            const b2Vec2& c = vertices[(i + 2) % vertices.size()];
+            float cross = (b.x - a.x) * (c.y - b.y) - (b.y - a.y) * (c.x - b.x);
+            if (cross <= 0.0f)
+                return error("polygon " + polygons.back().id + " is not convex and counter-clockwise"
+                        " at vertex " + std::to_string((i + 1) % vertices.size()));
+        }
+
+        // Set() drops vertices which aren't on the hull, so a concave polygon ends up with fewer
+        b2PolygonShape& shape = polygons.back().shape;
+        shape.Set(vertices.data(), vertices.size());
+        if (shape.m_count != (int)vertices.size() || !shape.Validate())
+            return error("polygon " + polygons.back().id + " is not convex");
+        return true;
+    };
+
+    auto addId = [&](const std::string& id) {
+        if (id.empty())
+            return error("missing id");
+        if (!ids.insert(id).second)
+            return error("duplicate id " + id);
+        return true;
+    };
+
+    while (std::getline(lines, line)) {
+
+        ++lineNumber;
+
+        // strip comments
+        std::size_t comment = line.find('#');
+        if (comment != std::string::npos)
+            line.erase(comment);
+
+        std::istringstream words(line);
+        std::string keyword;
+        if (!(words >> keyword))
+            continue;
+
+        // frames and vertices belong to the sprite or polygon above them
+        if (keyword == "frame") {
+            sf::IntRect frame;
+            if (!isReadingSprite)
+                return error("frame outside of a sprite");
+            if (!(words >> frame.left >> frame.top >> frame.width >> frame.height))
+                return error("expected: frame <left> <top> <width> <height>");
+            if (frame.left < 0 || frame.top < 0 || frame.width <= 0 || frame.height <= 0)
+                return error("frame of sprite " + sprites.back().id + " is out of bounds");
+            sprites.back().frames.push_back(frame);
+            continue;
+        }
+
+        if (keyword == "size") {
+            unsigned int characterSize;
+            if (!isReadingFont)
+                return error("size outside of a font");
+            if (!(words >> characterSize) || characterSize == 0)
+                return error("expected: size <character size>");
+            fonts.back().characterSizes.push_back(characterSize);
+            continue;
+        }
+
+        // a polygon can be traced from a sprite frame instead of listing its vertices
+        if (keyword == "trace") {
+
+            std::string spriteId;
+            std::size_t frameIndex;
+            int maxVertices;
+            if (!isReadingPolygon || !vertices.empty())
+                return error("trace must be the only thing in a polygon");
+            if (!(words >> spriteId >> frameIndex >> maxVertices))
+                return error("expected: trace <sprite id> <frame> <max vertices>");
+            if (maxVertices < 3 || maxVertices > b2_maxPolygonVertices)
+                return error("max vertices must be between 3 and " +
+                        std::to_string(b2_maxPolygonVertices));
+
+            auto sprite = std::find_if(sprites.begin(), sprites.end(),
+                    [&spriteId](const Sprite& s) { return s.id == spriteId; });
+            if (sprite == sprites.end())
+                return error("unknown sprite " + spriteId);
+            if (frameIndex >= sprite->frames.size())
+                return error("sprite " + spriteId + " has no frame " + std::to_string(frameIndex));
+
+            auto texture = std::find_if(textures.begin(), textures.end(),
+                    [&sprite](const Texture& t) { return t.id == sprite->textureId; });
+            if (images.find(texture->id) == images.end() &&
+                    !images[texture->id].loadFromFile(texture->filename))
+                return error("unable to load " + texture->filename);
+            const sf::Image& image = images[texture->id];
+
+            const sf::IntRect& frame = sprite->frames[frameIndex];
+            if (frame.left + frame.width > (int)image.getSize().x ||
+                    frame.top + frame.height > (int)image.getSize().y)
+                return error("frame " + std::to_string(frameIndex) + " of sprite " + spriteId +
+                        " is outside of its texture");
+
+            vertices = traceConvexHull(image, frame, maxVertices);
+            if (vertices.empty())
+                return error("frame " + std::to_string(frameIndex) + " of sprite " + spriteId +
+                        " has no opaque pixels");
+            isTraced = true;
+            continue;
+        }
+
+        if (keyword == "vertex") {
+            b2Vec2 vertex;
+            if (!isReadingPolygon)
+                return error("vertex outside of a polygon");
+            if (isTraced)
+                return error("trace must be the only thing in a polygon");
+            if (!(words >> vertex.x >> vertex.y))
+                return error("expected: vertex <x> <y>");
+            vertices.push_back(vertex);
+            continue;
+        }
+
+        // anything else starts a new resource
+        if (isReadingSprite && sprites.back().frames.empty())
+            return error("sprite " + sprites.back().id + " has no frames");
+        isReadingSprite = false;
+        isReadingFont = false;
+        if (isReadingPolygon && !finishPolygon())
+            return false;
+
+        if (keyword == "texture") {
+            Texture texture;
+            if (!(words >> texture.id >> texture.filename))
+                return error("expected: texture <id> <image file>");
+            if (!addId(texture.id))
+                return false;
+            textureIds.insert(texture.id);
+            textures.push_back(texture);
+
+        } else if (keyword == "sprite") {
+            Sprite sprite;
+            if (!(words >> sprite.id >> sprite.textureId >> sprite.scaleFactor))
+                return error("expected: sprite <id> <texture id> <scale factor>");
+            if (!addId(sprite.id))
+                return false;
+            if (textureIds.find(sprite.textureId) == textureIds.end())
+                return error("sprite " + sprite.id + " uses unknown texture " + sprite.textureId);
+            sprites.push_back(sprite);
+            isReadingSprite = true;
+
+        } else if (keyword == "font") {
+            Font font;
+            if (!(words >> font.id >> font.filename))
+                return error("expected: font <id> <font file>");
+            if (!addId(font.id))
+                return false;
+            fonts.push_back(font);
+            isReadingFont = true;
+
+        } else if (keyword == "polygon") {
+            Polygon polygon;
+            if (!(words >> polygon.id))
+                return error("expected: polygon <id>");
+            if (!addId(polygon.id))
+                return false;
+            polygons.push_back(polygon);
+            vertices.clear();
+            isReadingPolygon = true;
+            isTraced = false;
+
+        } else {
+            return error("unknown keyword " + keyword);
+        }
+    }
+
+    // finish whatever was being read at the end of the file
+    if (isReadingSprite && sprites.back().frames.empty())
+        return error("sprite " + sprites.back().id + " has no frames");
+    if (isReadingPolygon && !finishPolygon())
+        return false;
+
+    return true;
+}
+
+bool ResourceManifest::parseBinary(const std::string& contents, const std::string& filename) {
+
+    BinaryReader reader(contents);
+    for (std::size_t i = 0; i < sizeof(MAGIC); ++i)
+        reader.read<char>();
+
+    if (reader.read<std::uint32_t>() != VERSION) {
+        std::cerr << "resource manifest has the wrong version: " << filename << std::endl;
+        return false;
+    }
+
+    std::uint32_t numTextures = reader.read<std::uint32_t>();
+    std::uint32_t numSprites = reader.read<std::uint32_t>();
+    std::uint32_t numFonts = reader.read<std::uint32_t>();
+    std::uint32_t numPolygons = reader.read<std::uint32_t>();
+
+    for (std::uint32_t i = 0; i < numTextures && reader.isOk(); ++i) {
+        Texture texture;
+        texture.id = reader.readString();
+        texture.filename = reader.readString();
+        textures.push_back(texture);
+    }
+
+    for (std::uint32_t i = 0; i < numSprites && reader.isOk(); ++i) {
+        Sprite sprite;
+        sprite.id = reader.readString();
+        sprite.textureId = reader.readString();
+        sprite.scaleFactor = reader.read<float>();
+        std::uint32_t numFrames = reader.read<std::uint32_t>();
+        for (std::uint32_t j = 0; j < numFrames && reader.isOk(); ++j) {
+            sf::IntRect frame;
+            frame.left = reader.read<std::int32_t>();
+            frame.top = reader.read<std::int32_t>();
+            frame.width = reader.read<std::int32_t>();
+            frame.height = reader.read<std::int32_t>();
+            sprite.frames.push_back(frame);
+        }
+        sprites.push_back(sprite);
+    }
+
+    for (std::uint32_t i = 0; i < numFonts && reader.isOk(); ++i) {
+        Font font;
+        font.id = reader.readString();
+        font.filename = reader.readString();
+        std::uint32_t numSizes = reader.read<std::uint32_t>();
+        for (std::uint32_t j = 0; j < numSizes && reader.isOk(); ++j)
+            font.characterSizes.push_back(reader.read<std::uint32_t>());
+        fonts.push_back(font);
+    }
+
+    // the shapes were validated when the manifest was compiled, so they're copied in as they are
+    for (std::uint32_t i = 0; i < numPolygons && reader.isOk(); ++i) {
+        Polygon polygon;
+        polygon.id = reader.readString();
+        b2PolygonShape& shape = polygon.shape;
+        shape.m_count = reader.read<std::int32_t>();
+        if (shape.m_count < 3 || shape.m_count > b2_maxPolygonVertices)
+            break;
+        shape.m_radius = reader.read<float>();
+        shape.m_centroid.x = reader.read<float>();
+        shape.m_centroid.y = reader.read<float>();
+        for (int j = 0; j < shape.m_count; ++j) {
+            shape.m_vertices[j].x = reader.read<float>();
+            shape.m_vertices[j].y = reader.read<float>();
+            shape.m_normals[j].x = reader.read<float>();
+            shape.m_normals[j].y = reader.read<float>();
+        }
+        polygons.push_back(polygon);
+    }
+
+    if (!reader.isOk() || !reader.isAtEnd() || polygons.size() != numPolygons) {
+        std::cerr << "corrupt resource manifest: " << filename << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+void ResourceManifest::clear() {
+    textures.clear();
+    sprites.clear();
+    fonts.clear();
+    polygons.clear();
+    _loaded = false;
+}
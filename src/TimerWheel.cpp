@@ -0,0 +1,204 @@
+#include <cassert>
+#include <cmath>
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "TimerWheel.hpp"
+
+namespace {
+
+    // bits of the tick used for the slot index of each level
+    const int FIRST_LEVEL_BITS = 8;
+    const int LEVEL_BITS = 6;
+
+    // number of bits of the tick below the slot index of the given level
+    int levelShift(const int& level) {
+        return level == 0 ? 0 : FIRST_LEVEL_BITS + (level - 1) * LEVEL_BITS;
+    }
+
+    // first slot of the given level in _slots
+    int levelStart(const int& level) {
+        return level == 0 ? 0 : 256 + (level - 1) * 64;
+    }
+
+    // index of the slot within the given level that the given tick falls into
+    int slotInLevel(const std::uint64_t& tick, const int& level) {
+        if (level == 0)
+            return tick & 255;
+        return (tick >> levelShift(level)) & 63;
+    }
+}
+
+TimerWheel::TimerWheel(const float& tickDuration) :
+    _TICK_DURATION(tickDuration),
+    _time(0.0),
+    _currentTick(0),
+    _slots(_NUM_FIRST_SLOTS + (_NUM_LEVELS - 1) * _NUM_SLOTS, -1),
+    _firstFree(-1)
+{
+    assert(tickDuration > 0.0f);
+}
+
+TimerWheel::Handle TimerWheel::schedule(const float& delay, const std::function<void()>& function) {
+
+    // take a timer from the pool, or grow the pool if it's empty
+    int index = _firstFree;
+    if (index >= 0) {
+        _firstFree = _timers[index].next;
+    } else {
+        index = _timers.size();
+        _timers.push_back(Timer());
+        _timers.back().generation = 1;
+    }
+
+    // The timer expires at the first tick at or after its expiry time, but never at the tick
+    // that's currently being called, since that tick's slot is being emptied.
+    Timer& timer = _timers[index];
+    timer.function = function;
+    timer.expiryTick = std::max((std::uint64_t)std::ceil((_time + delay) / _TICK_DURATION),
+            _currentTick + 1);
+    insert(index);
+
+    return ((Handle)timer.generation << 32) | (std::uint32_t)index;
+}
+
+void TimerWheel::cancel(Handle& handle) {
+
+    if (isPending(handle)) {
+        int index = handle & 0xffffffff;
+        unlink(index);
+        free(index);
+    }
+
+    handle = NO_TIMER;
+}
+
+bool TimerWheel::isPending(const Handle& handle) const {
+
+    std::size_t index = handle & 0xffffffff;
+    std::uint32_t generation = handle >> 32;
+
+    return handle != NO_TIMER && index < _timers.size() &&
+            _timers[index].generation == generation && _timers[index].slot >= 0;
+}
+
+void TimerWheel::clear() {
+
+    for (std::size_t i = 0; i < _timers.size(); ++i) {
+        if (_timers[i].slot >= 0)
+            free(i);
+    }
+
+    std::fill(_slots.begin(), _slots.end(), -1);
+}
+
+void TimerWheel::advance(const float& timeDelta) {
+
+    double endTime = _time + timeDelta;
+    std::uint64_t targetTick = (std::uint64_t)std::floor(endTime / _TICK_DURATION);
+
+    while (_currentTick < targetTick) {
+
+        // while the tick's timers are called, it's the time of the tick, so that timers which are
+        // scheduled by them are timed from when they expired rather than from the end of the step
+        ++_currentTick;
+        _time = _currentTick * _TICK_DURATION;
+
+        // whenever a level wraps around, the timers in the next slot of the level above move down
+        int slot = slotInLevel(_currentTick, 0);
+        if (slot == 0) {
+            for (int level = 1; level < _NUM_LEVELS; ++level) {
+                if (cascade(level, slotInLevel(_currentTick, level)) != 0)
+                    break;
+            }
+        }
+
+        // Call every timer in the tick's slot. Timers are taken off one at a time, since any of the
+        // functions may cancel others in the slot; any timers they schedule go into other slots.
+        while (_slots[slot] >= 0) {
+
+            int index = _slots[slot];
+            assert(_timers[index].expiryTick == _currentTick);
+
+            // the function may schedule timers, which can move the pool, so take it out first
+            std::function<void()> function;
+            function.swap(_timers[index].function);
+            unlink(index);
+            free(index);
+
+            function();
+        }
+    }
+
+    _time = endTime;
+}
+
+void TimerWheel::insert(const int& index) {
+
+    Timer& timer = _timers[index];
+    assert(timer.expiryTick >= _currentTick);
+
+    // The timer goes into the lowest level which has a slot for its expiry tick, i.e. the lowest
+    // level whose slots the tick is less than a wheel's turn of slots ahead of. Timers further out
+    // than the top level reaches are put in the last slot that it cascades before wrapping around,
+    // so that they're put back in whenever it is cascaded.
+    std::uint64_t slotTick = timer.expiryTick;
+    int level = 0;
+    std::uint64_t numSlots = _NUM_FIRST_SLOTS;
+    while ((slotTick >> levelShift(level)) - (_currentTick >> levelShift(level)) >= numSlots) {
+        if (level == _NUM_LEVELS - 1) {
+            slotTick = _currentTick + ((numSlots - 1) << levelShift(level));
+            break;
+        }
+        ++level;
+        numSlots = _NUM_SLOTS;
+    }
+
+    // add the timer to the front of the slot's list
+    timer.slot = levelStart(level) + slotInLevel(slotTick, level);
+    timer.previous = -1;
+    timer.next = _slots[timer.slot];
+    if (timer.next >= 0)
+        _timers[timer.next].previous = index;
+    _slots[timer.slot] = index;
+}
+
+void TimerWheel::unlink(const int& index) {
+
+    Timer& timer = _timers[index];
+    assert(timer.slot >= 0);
+
+    if (timer.previous >= 0)
+        _timers[timer.previous].next = timer.next;
+    else
+        _slots[timer.slot] = timer.next;
+    if (timer.next >= 0)
+        _timers[timer.next].previous = timer.previous;
+}
+
+void TimerWheel::free(const int& index) {
+
+    Timer& timer = _timers[index];
+
+    timer.function = nullptr;
+    timer.slot = -1;
+    timer.generation = timer.generation == UINT32_MAX ? 1 : timer.generation + 1;
+    timer.next = _firstFree;
+    _firstFree = index;
+}
+
+int TimerWheel::cascade(const int& level, const int& slot) {
+
+    // take the whole list off the slot, then put each of its timers where it now belongs
+    int index = _slots[levelStart(level) + slot];
+    _slots[levelStart(level) + slot] = -1;
+    while (index >= 0) {
+        int next = _timers[index].next;
+        insert(index);
+        index = next;
+    }
+
+    return slot;
+}
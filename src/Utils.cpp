@@ -1,4 +1,6 @@
 #include <cassert>
+#include <vector>
+#include <algorithm>
 
 #include <SFML/Graphics.hpp>
 #include <box2d/box2d.h>
@@ -59,6 +61,107 @@ void fitPolygonToSprite(b2PolygonShape& polygon, const sf::Sprite& sprite) {
     ));
 }
 
+std::vector<b2Vec2> traceConvexHull(const sf::Image& image, const sf::IntRect& rect,
+        const int& maxVertices, const sf::Uint8& alphaThreshold) {
+
+    assert(maxVertices >= 3);
+    assert(rect.left >= 0 && rect.top >= 0 && rect.left + rect.width <= (int)image.getSize().x &&
+            rect.top + rect.height <= (int)image.getSize().y);
+
+    // The hull of the opaque pixels is the hull of the outer corners of the leftmost and rightmost
+    // opaque pixel of each row. Points are in pixels from the rectangle's top-left, y pointing down.
+    const sf::Uint8* pixels = image.getPixelsPtr();
+    std::vector<sf::Vector2i> points;
+    for (int y = 0; y < rect.height; ++y) {
+
+        const sf::Uint8* row = pixels + ((rect.top + y) * image.getSize().x + rect.left) * 4;
+        int left = 0;
+        while (left < rect.width && row[left * 4 + 3] < alphaThreshold)
+            ++left;
+        if (left == rect.width)
+            continue;
+        int right = rect.width - 1;
+        while (row[right * 4 + 3] < alphaThreshold)
+            --right;
+
+        points.push_back(sf::Vector2i(left, y));
+        points.push_back(sf::Vector2i(left, y + 1));
+        points.push_back(sf::Vector2i(right + 1, y));
+        points.push_back(sf::Vector2i(right + 1, y + 1));
+    }
+
+    if (points.empty())
+        return std::vector<b2Vec2>();
+
+    // Andrew's monotone chain; only strict turns are kept, so no three vertices are collinear
+    std::sort(points.begin(), points.end(), [](const sf::Vector2i& a, const sf::Vector2i& b) {
+        return a.x < b.x || (a.x == b.x && a.y < b.y);
+    });
+    auto turn = [](const sf::Vector2i& o, const sf::Vector2i& a, const sf::Vector2i& b) {
+        return (long long)(a.x - o.x) * (b.y - o.y) - (long long)(a.y - o.y) * (b.x - o.x);
+    };
+    std::vector<sf::Vector2i> hull(2 * points.size());
+    int k = 0;
+    for (int i = 0; i < (int)points.size(); ++i) {
+        while (k >= 2 && turn(hull[k - 2], hull[k - 1], points[i]) <= 0)
+            --k;
+        hull[k++] = points[i];
+    }
+    for (int i = points.size() - 2, lower = k + 1; i >= 0; --i) {
+        while (k >= lower && turn(hull[k - 2], hull[k - 1], points[i]) <= 0)
+            --k;
+        hull[k++] = points[i];
+    }
+    hull.resize(k - 1);
+
+    // Normalize, which also flips y to point up. That flips the winding too, so go through the
+    // hull backwards to end up counter-clockwise.
+    std::vector<b2Vec2> vertices;
+    for (auto i = hull.rbegin(); i != hull.rend(); ++i) {
+        vertices.push_back(b2Vec2(
+            (float)i->x / rect.width - 0.5f,
+            0.5f - (float)i->y / rect.height
+        ));
+    }
+
+    // area of the triangle which a vertex forms with its neighbors, i.e. what removing it costs
+    auto areaLost = [&vertices](const int& i) {
+        const int n = vertices.size();
+        const b2Vec2& a = vertices[(i + n - 1) % n];
+        const b2Vec2& b = vertices[i];
+        const b2Vec2& c = vertices[(i + 1) % n];
+        return 0.5f * ((b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x));
+    };
+
+    // Simplify until the hull fits the budget and box2d won't weld any vertices together. When an
+    // edge is too short, one of its two ends has to go; otherwise any vertex can.
+    while (vertices.size() > 3) {
+
+        const int n = vertices.size();
+        int shortEdge = -1;
+        for (int i = 0; i < n && shortEdge < 0; ++i) {
+            float dx = vertices[(i + 1) % n].x - vertices[i].x;
+            float dy = vertices[(i + 1) % n].y - vertices[i].y;
+            if (dx * dx + dy * dy < b2_linearSlop * b2_linearSlop)
+                shortEdge = i;
+        }
+
+        if (n <= maxVertices && shortEdge < 0)
+            break;
+
+        int remove = -1;
+        for (int i = 0; i < n; ++i) {
+            if (shortEdge >= 0 && i != shortEdge && i != (shortEdge + 1) % n)
+                continue;
+            if (remove < 0 || areaLost(i) < areaLost(remove))
+                remove = i;
+        }
+        vertices.erase(vertices.begin() + remove);
+    }
+
+    return vertices;
+}
+
 void centerTextOnPoint(sf::Text& text, const sf::Vector2f& point) {
 
     sf::FloatRect bounds = text.getLocalBounds();
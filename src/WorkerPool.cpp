@@ -0,0 +1,74 @@
+#include <cassert>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#include "WorkerPool.hpp"
+
+WorkerPool::WorkerPool(unsigned numThreads) :
+    _numRunning(0),
+    _stopping(false)
+{
+    // leave one hardware thread for the main thread
+    if (numThreads == 0) {
+        unsigned hardwareThreads = std::thread::hardware_concurrency();
+        numThreads = hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+    }
+
+    for (unsigned i = 0; i < numThreads; ++i)
+        _threads.push_back(std::thread(&WorkerPool::workerLoop, this));
+}
+
+WorkerPool::~WorkerPool() {
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stopping = true;
+    }
+    _taskCondition.notify_all();
+
+    for (std::thread& thread : _threads)
+        thread.join();
+}
+
+void WorkerPool::push(const std::function<void()>& task) {
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        assert(!_stopping);
+        _tasks.push(task);
+    }
+    _taskCondition.notify_one();
+}
+
+void WorkerPool::wait() {
+    std::unique_lock<std::mutex> lock(_mutex);
+    _idleCondition.wait(lock, [this]() { return _tasks.empty() && _numRunning == 0; });
+}
+
+void WorkerPool::workerLoop() {
+
+    while (true) {
+
+        // wait for a task, or for the pool to stop
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _taskCondition.wait(lock, [this]() { return _stopping || !_tasks.empty(); });
+            if (_stopping)
+                return;
+            task = _tasks.front();
+            _tasks.pop();
+            ++_numRunning;
+        }
+
+        task();
+
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            --_numRunning;
+        }
+        _idleCondition.notify_all();
+    }
+}
@@ -1,5 +1,5 @@
 /**
- * Sets the TYPE attribute of all classes which inherit from Event.
+ * Sets the TYPE attribute of all classes which inherit from Event, and maps those types to names.
  */
 
 #include "Event.hpp"
@@ -26,3 +26,18 @@ const EventType ButtonClickEvent::TYPE =  (EventType)&ButtonClickEvent::TYPE;
 const EventType GamePauseEvent::TYPE =    (EventType)&GamePauseEvent::TYPE;
 const EventType CollisionEvent::TYPE =    (EventType)&CollisionEvent::TYPE;
 const EventType GameOverEvent::TYPE =     (EventType)&GameOverEvent::TYPE;
+
+const char* getEventTypeName(const EventType& type) {
+    if (type == WindowResizeEvent::TYPE) return "WindowResizeEvent";
+    if (type == WindowCloseEvent::TYPE)  return "WindowCloseEvent";
+    if (type == KeyPressEvent::TYPE)     return "KeyPressEvent";
+    if (type == KeyReleaseEvent::TYPE)   return "KeyReleaseEvent";
+    if (type == MouseMoveEvent::TYPE)    return "MouseMoveEvent";
+    if (type == MousePressEvent::TYPE)   return "MousePressEvent";
+    if (type == MouseReleaseEvent::TYPE) return "MouseReleaseEvent";
+    if (type == ButtonClickEvent::TYPE)  return "ButtonClickEvent";
+    if (type == GamePauseEvent::TYPE)    return "GamePauseEvent";
+    if (type == CollisionEvent::TYPE)    return "CollisionEvent";
+    if (type == GameOverEvent::TYPE)     return "GameOverEvent";
+    return "UnknownEvent";
+}